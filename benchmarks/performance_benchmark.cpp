@@ -4,10 +4,23 @@
  */
 
 #include "scheduler.h"
+#include "workload_generator.h"
+#include "submission_channel.h"
+#include "executor.h"
+#include "coroutine_task.h"
+#include "arrival_order.h"
+#include "result_columns.h"
+#include "benchmark_baseline.h"
+#include "batch.h"
+#include <algorithm>
 #include <iostream>
 #include <chrono>
+#include <cstring>
+#include <fstream>
 #include <iomanip>
+#include <memory>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 using namespace std;
@@ -77,17 +90,303 @@ BenchmarkResult benchmarkAlgorithm(Scheduler* scheduler,
 }
 
 vector<Process> generateProcesses(int count) {
-    vector<Process> processes;
-    for (int i = 0; i < count; i++) {
-        int arrival = i / 2;
-        int burst = 5 + (i % 10);
-        int priority = i % 5;
-        processes.push_back(Process(i + 1, arrival, burst, priority));
+    // Poisson arrivals with heavy-tailed bursts at roughly 80% offered load
+    WorkloadConfig config;
+    config.count = count;
+    config.seed = 42;
+    config.arrivals = ARRIVAL_POISSON;
+    config.arrivalRate = 0.08;
+    config.bursts = BURST_LOGNORMAL;
+    config.meanBurst = 10.0;
+    return WorkloadGenerator(config).take(count);
+}
+
+// Pushes total arrivals from the given number of producer threads through a
+// SubmissionChannel into a running Round Robin simulation.
+// Returns submitted arrivals per second.
+double benchmarkSubmissionChannel(int producers, int total) {
+    SubmissionChannel channel(producers, 1024);
+    RoundRobinScheduler rr(4, 1);
+    rr.setTraceLevel(TRACE_NONE);
+    int perProducer = total / producers;
+    
+    auto start = high_resolution_clock::now();
+    
+    vector<thread> threads;
+    for (int id = 0; id < producers; id++) {
+        threads.emplace_back([&channel, id, perProducer, producers]() {
+            WorkloadConfig config;
+            config.count = perProducer;
+            config.seed = id + 1;
+            config.arrivalRate = 0.08 / producers;
+            WorkloadGenerator generator(config);
+            while (generator.hasNext()) {
+                Process p = generator.next();
+                p.pid = id * perProducer + p.pid;
+                channel.push(id, p);
+            }
+            channel.close(id);
+        });
+    }
+    
+    vector<Process> completed;
+    size_t submitted = 0;
+    while (!channel.finished()) {
+        submitted += channel.feed(rr);
+        rr.drainCompleted(completed);
+        completed.clear();
+        this_thread::yield();
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    
+    auto end = high_resolution_clock::now();
+    double seconds = duration_cast<microseconds>(end - start).count() / 1e6;
+    return submitted / seconds;
+}
+
+// One simulated time unit of real work in the executor comparison
+const int WORK_UNIT_MICROS = 20;
+
+// Runs the workload's bursts as spinning tasks on a single executor worker
+// (all arriving at once) and returns the measured average turnaround in
+// work units, for comparison with the simulator's prediction.
+double measureExecutorTurnaround(ExecutorPolicy policy, int quantumUnits,
+                                 const vector<Process>& workload) {
+    TaskExecutor executor(policy, 1, quantumUnits * WORK_UNIT_MICROS);
+    for (const auto& p : workload) {
+        auto remaining = make_shared<int>(p.burstTime);
+        executor.submit([remaining](TaskContext& context) {
+            while (*remaining > 0) {
+                auto until = high_resolution_clock::now() + microseconds(WORK_UNIT_MICROS);
+                while (high_resolution_clock::now() < until) {}
+                if (--(*remaining) > 0 && context.shouldYield()) return false;
+            }
+            return true;
+        }, p.priority);
+    }
+    executor.waitIdle();
+    return executor.report().metrics.turnaround.getMean() / WORK_UNIT_MICROS;
+}
+
+double simulateTurnaround(Scheduler* scheduler, const vector<Process>& workload) {
+    scheduler->setTraceLevel(TRACE_NONE);
+    for (const auto& p : workload) {
+        scheduler->addProcess(Process(p.pid, 0, p.burstTime, p.priority));
+    }
+    scheduler->schedule();
+    return scheduler->getAverageTurnaroundTime();
+}
+
+// Lightweight coroutine task: a few chunks of arithmetic between yield points
+PreemptibleTask lightweightTask(int chunks, volatile unsigned* sink) {
+    unsigned value = chunks;
+    for (int i = 0; i < chunks; i++) {
+        for (int j = 0; j < 64; j++) {
+            value = value * 1664525u + 1013904223u;
+        }
+        co_await yieldPoint();
+    }
+    *sink = value;
+}
+
+ExecutorReport benchmarkCoroutines(ExecutorPolicy policy, int tasks, int quantumMicros) {
+    static volatile unsigned sink;
+    TaskExecutor executor(policy, thread::hardware_concurrency(), quantumMicros);
+    executor.start();
+    
+    vector<Process> records;
+    for (int i = 0; i < tasks; i++) {
+        submitTask(executor, lightweightTask(1 + i % 8, &sink), i % 6);
+        if (i % 65536 == 0) {
+            executor.drainCompleted(records);
+            records.clear();
+        }
+    }
+    executor.waitIdle();
+    return executor.report();
+}
+
+// Milliseconds to put a workload in arrival order with std::sort on records
+// versus the radix key sort (plus gather), and for a cache hit
+void benchmarkArrivalOrdering(const vector<Process>& processes, double& stdSortMs,
+                              double& radixMs, double& cachedMs) {
+    vector<Process> copy = processes;
+    auto start = high_resolution_clock::now();
+    sort(copy.begin(), copy.end(),
+         [](const Process& a, const Process& b) { return a.arrivalTime < b.arrivalTime; });
+    stdSortMs = duration<double, milli>(high_resolution_clock::now() - start).count();
+    
+    copy = processes;
+    start = high_resolution_clock::now();
+    auto sorted = sortedWorkload(move(copy));
+    radixMs = duration<double, milli>(high_resolution_clock::now() - start).count();
+    
+    copy = processes;
+    start = high_resolution_clock::now();
+    auto again = sortedWorkload(move(copy));
+    cachedMs = duration<double, milli>(high_resolution_clock::now() - start).count();
+}
+
+// Synthetic finished-process rows with realistic ranges; the kernel's cost
+// does not depend on which policy produced them
+ResultColumns syntheticColumns(size_t rows) {
+    ResultColumns columns;
+    columns.levels = 3;
+    columns.levelNames[0] = "Q0";
+    columns.levelNames[1] = "Q1";
+    columns.levelNames[2] = "Q2";
+    columns.reserve(rows);
+    FastRandom random(5);
+    int arrival = 0;
+    for (size_t i = 0; i < rows; i++) {
+        arrival += random.next() % 20;
+        Process p((int)i, arrival, 1 + random.next() % 40, random.next() % 6);
+        int waiting = random.next() % 200;
+        p.startTime = arrival + random.next() % (waiting + 1);
+        p.completionTime = arrival + waiting + p.burstTime;
+        columns.append(p, random.next() % 3);
     }
-    return processes;
+    return columns;
 }
 
-int main() {
+// The per-process path: derive each row's metrics and fold them one at a time
+MetricsBreakdown perRowBreakdown(const ResultColumns& columns) {
+    MetricsBreakdown report;
+    report.levels = columns.levels;
+    for (size_t i = 0; i < columns.size(); i++) {
+        int turnaround = columns.completion[i] - columns.arrival[i];
+        int waiting = turnaround - columns.burst[i];
+        int response = columns.start[i] - columns.arrival[i];
+        report.overall.waiting.add(waiting);
+        report.overall.turnaround.add(turnaround);
+        report.overall.response.add(response);
+        for (MetricsGroup* group : {&report.byPriority[columns.priority[i]], &report.byLevel[columns.level[i]]}) {
+            group->count++;
+            group->waiting += waiting;
+            group->turnaround += turnaround;
+            group->response += response;
+        }
+    }
+    return report;
+}
+
+// Fixed work that no change to the scheduler affects: sorting the same
+// pseudo-random keys. Its timing tracks the speed of the machine.
+double calibrationMs() {
+    static vector<uint64_t> keys;
+    if (keys.empty()) {
+        FastRandom random(99);
+        for (int i = 0; i < 400000; i++) {
+            keys.push_back(random.next());
+        }
+    }
+    vector<uint64_t> copy = keys;
+    auto start = high_resolution_clock::now();
+    sort(copy.begin(), copy.end());
+    return duration<double, milli>(high_resolution_clock::now() - start).count();
+}
+
+// Regression suite: every policy on a few workload sizes, plus the
+// calibration task. Samples are taken round-robin over the cases, so a slow
+// spell on the machine spreads over all of them instead of landing on one.
+vector<BenchmarkCase> runRegressionSuite(int samples) {
+    const vector<string> algorithms = {"rr", "arr", "pp", "npp", "mlq", "mlfq", "sjf", "pmlfq"};
+    const vector<int> sizes = {1000, 10000, 100000};
+    
+    vector<vector<Process>> workloads;
+    vector<BenchmarkCase> cases;
+    for (int size : sizes) {
+        workloads.push_back(generateProcesses(size));
+        for (const auto& algorithm : algorithms) {
+            cases.push_back(BenchmarkCase{algorithm, (uint64_t)size, SimulatedOutcome(), {}});
+        }
+    }
+    
+    BenchmarkCase calibration{CALIBRATION_CASE, 0, SimulatedOutcome(), {}};
+    
+    for (int sample = 0; sample < samples; sample++) {
+        calibration.samplesMs.push_back(calibrationMs());
+        for (size_t i = 0; i < cases.size(); i++) {
+            BenchmarkCase& c = cases[i];
+            auto scheduler = makeScheduler(c.algorithm, 4, 1);
+            scheduler->setTraceLevel(TRACE_NONE);
+            scheduler->setRetention(RETAIN_AGGREGATES);
+            for (const auto& p : workloads[i / algorithms.size()]) {
+                scheduler->addProcess(p);
+            }
+            
+            auto start = high_resolution_clock::now();
+            scheduler->schedule();
+            c.samplesMs.push_back(duration<double, milli>(high_resolution_clock::now() - start).count());
+            c.outcome = outcomeOf(*scheduler);
+        }
+    }
+    cases.push_back(calibration);
+    return cases;
+}
+
+void printBenchmarkUsage(const char* program) {
+    cout << "Usage: " << program << " [--save-baseline FILE | --compare FILE] [--samples N]\n"
+         << "Without options, prints the full benchmark report.\n\n"
+         << "  --save-baseline FILE   Run the regression suite and save its timings and outcomes\n"
+         << "  --compare FILE         Run the regression suite and compare it with a saved baseline;\n"
+         << "                         exits with status 1 when a case is slower or its outcome drifted\n"
+         << "  --samples N            Timing samples per case (default: 15)\n";
+}
+
+// Returns the exit status
+int runBaselineMode(const string& savePath, const string& comparePath, int samples) {
+    vector<BenchmarkCase> baseline;
+    if (!comparePath.empty()) {
+        ifstream in(comparePath);
+        if (!in) {
+            throw runtime_error("cannot read '" + comparePath + "'");
+        }
+        baseline = loadBaseline(in);
+    }
+    
+    cout << "Running the regression suite (" << samples << " samples per case)...\n";
+    vector<BenchmarkCase> cases = runRegressionSuite(samples);
+    
+    if (!savePath.empty()) {
+        ofstream out(savePath);
+        if (!out) {
+            throw runtime_error("cannot write '" + savePath + "'");
+        }
+        saveBaseline(out, cases);
+        cout << "Saved " << cases.size() - 1 << " cases to " << savePath << "\n";
+    }
+    if (comparePath.empty()) return 0;
+    return writeComparison(cout, compareToBaseline(baseline, cases)) > 0 ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+    string savePath, comparePath;
+    int samples = 15;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 < argc && arg == "--save-baseline") {
+            savePath = argv[++i];
+        } else if (i + 1 < argc && arg == "--compare") {
+            comparePath = argv[++i];
+        } else if (i + 1 < argc && arg == "--samples" && (samples = atoi(argv[++i])) >= 2) {
+            continue;
+        } else {
+            printBenchmarkUsage(argv[0]);
+            return 2;
+        }
+    }
+    if (!savePath.empty() || !comparePath.empty()) {
+        try {
+            return runBaselineMode(savePath, comparePath, samples);
+        } catch (const exception& e) {
+            cerr << argv[0] << ": " << e.what() << "\n";
+            return 2;
+        }
+    }
+    
     cout << "\n========================================\n";
     cout << "  CPU Scheduler Performance Benchmark\n";
     cout << "========================================\n";
@@ -143,6 +442,167 @@ int main() {
         cout << string(82, '=') << "\n";
     }
     
+    cout << "\n========== Arrival Ordering (4,000,000 processes, ms) ==========\n";
+    cout << left << setw(20) << "Input"
+         << right << setw(14) << "std::sort"
+         << setw(14) << "Radix"
+         << setw(14) << "Cache hit" << endl;
+    cout << string(62, '-') << endl;
+    {
+        WorkloadConfig config;
+        config.count = 4000000;
+        vector<Process> ordered = WorkloadGenerator(config).take(config.count);
+        vector<Process> shuffled = ordered;
+        FastRandom random(7);
+        for (size_t i = shuffled.size() - 1; i > 0; i--) {
+            swap(shuffled[i], shuffled[random.next() % (i + 1)]);
+        }
+        
+        for (auto& input : {make_pair("Shuffled", &shuffled), make_pair("Presorted", &ordered)}) {
+            double stdSortMs, radixMs, cachedMs;
+            benchmarkArrivalOrdering(*input.second, stdSortMs, radixMs, cachedMs);
+            cout << left << setw(20) << input.first
+                 << right << fixed << setprecision(1) << setw(14) << stdSortMs
+                 << setw(14) << radixMs
+                 << setw(14) << cachedMs << endl;
+        }
+    }
+    cout << string(62, '=') << "\n";
+    
+    cout << "\n========== Submission Channel Throughput ==========\n";
+    cout << left << setw(12) << "Producers"
+         << right << setw(15) << "Arrivals"
+         << setw(22) << "Arrivals/sec" << endl;
+    cout << string(49, '-') << endl;
+    for (int producers : {8, 16, 32}) {
+        int total = 1 << 20;
+        double rate = benchmarkSubmissionChannel(producers, total);
+        cout << left << setw(12) << producers
+             << right << setw(15) << total
+             << setw(22) << fixed << setprecision(0) << rate << endl;
+    }
+    cout << string(49, '=') << "\n";
+    
+    cout << "\n========== Executor vs Simulation (avg turnaround, units) ==========\n";
+    cout << left << setw(25) << "Policy"
+         << right << setw(15) << "Simulated"
+         << setw(15) << "Measured" << endl;
+    cout << string(55, '-') << endl;
+    {
+        auto workload = generateProcesses(200);
+        RoundRobinScheduler rr(4, 0);
+        PreemptivePriorityScheduler pp(0);
+        MultilevelFeedbackQueueScheduler mlfq(0);
+        
+        struct Comparison { const char* name; double simulated; double measured; };
+        vector<Comparison> rows = {
+            {"Round Robin (q=4)", simulateTurnaround(&rr, workload),
+             measureExecutorTurnaround(EXEC_ROUND_ROBIN, 4, workload)},
+            {"Preemptive Priority", simulateTurnaround(&pp, workload),
+             measureExecutorTurnaround(EXEC_PRIORITY, 4, workload)},
+            {"MLFQ (8/16/FCFS)", simulateTurnaround(&mlfq, workload),
+             measureExecutorTurnaround(EXEC_MLFQ, 8, workload)},
+        };
+        for (const auto& row : rows) {
+            cout << left << setw(25) << row.name
+                 << right << setw(15) << fixed << setprecision(2) << row.simulated
+                 << setw(15) << row.measured << endl;
+        }
+    }
+    cout << string(55, '=') << "\n";
+    
+    cout << "\n========== Coroutine Tasks (1,000,000 per policy) ==========\n";
+    cout << left << setw(20) << "Policy"
+         << right << setw(15) << "Tasks/sec"
+         << setw(14) << "Dispatches"
+         << setw(18) << "Switch cost(us)" << endl;
+    cout << string(67, '-') << endl;
+    {
+        struct PolicyRun { const char* name; ExecutorPolicy policy; int quantum; };
+        vector<PolicyRun> runs = {
+            {"Round Robin", EXEC_ROUND_ROBIN, 0},
+            {"Priority", EXEC_PRIORITY, 0},
+            {"MLFQ", EXEC_MLFQ, 1},
+        };
+        for (const auto& run : runs) {
+            ExecutorReport report = benchmarkCoroutines(run.policy, 1000000, run.quantum);
+            cout << left << setw(20) << run.name
+                 << right << setw(15) << fixed << setprecision(0) << report.throughput
+                 << setw(14) << report.dispatches
+                 << setw(18) << setprecision(3) << report.switchCostMicros << endl;
+        }
+        cout << "(simulated contextSwitchTime is a fixed 1 time unit)\n";
+    }
+    cout << string(67, '=') << "\n";
+    
+    cout << "\n========== Post-Run Metrics Kernel (ms) ==========\n";
+    cout << left << setw(14) << "Rows"
+         << right << setw(12) << "Per-row"
+         << setw(12) << "Columnar"
+         << setw(10) << "Speedup"
+         << setw(14) << "Mrows/sec"
+         << setw(9) << "Match" << endl;
+    cout << string(71, '-') << endl;
+    for (size_t rows : {1000000UL, 10000000UL, 100000000UL}) {
+        ResultColumns columns = syntheticColumns(rows);
+        
+        auto start = high_resolution_clock::now();
+        MetricsBreakdown scalar = perRowBreakdown(columns);
+        double scalarMs = duration<double, milli>(high_resolution_clock::now() - start).count();
+        start = high_resolution_clock::now();
+        MetricsBreakdown columnar = analyzeResults(columns);
+        double columnarMs = duration<double, milli>(high_resolution_clock::now() - start).count();
+        
+        bool match = columnar.overall.waiting.getSum() == scalar.overall.waiting.getSum() &&
+                     columnar.overall.turnaround.getPercentile(0.99) == scalar.overall.turnaround.getPercentile(0.99) &&
+                     columnar.byPriority[3].response == scalar.byPriority[3].response &&
+                     columnar.byLevel[2].count == scalar.byLevel[2].count;
+        cout << left << setw(14) << rows
+             << right << fixed << setprecision(1) << setw(12) << scalarMs
+             << setw(12) << columnarMs
+             << setw(9) << scalarMs / columnarMs << "x"
+             << setw(14) << rows / columnarMs / 1000.0
+             << setw(9) << (match ? "yes" : "NO") << endl;
+    }
+    cout << string(71, '=') << "\n";
+    
+    cout << "\n========== Phase Profile (200,000 processes, ms per phase) ==========\n";
+    if (!phaseProfilingEnabled()) {
+        cout << "(phase timers not compiled in; rebuild with make clean && make PROFILE=1 benchmark)\n";
+    } else {
+        cout << left << setw(24) << "Algorithm" << right;
+        for (int phase = 0; phase < PHASE_COUNT; phase++) {
+            cout << setw(12) << phaseName((SchedulerPhase)phase);
+        }
+        cout << endl << string(24 + 12 * PHASE_COUNT, '-') << endl;
+        
+        WorkloadConfig config;
+        config.count = 200000;
+        vector<Process> workload = WorkloadGenerator(config).take(config.count);
+        vector<unique_ptr<Scheduler>> schedulers;
+        schedulers.push_back(make_unique<RoundRobinScheduler>(4, 1));
+        schedulers.push_back(make_unique<PreemptivePriorityScheduler>(1));
+        schedulers.push_back(make_unique<NonPreemptivePriorityScheduler>(1));
+        schedulers.push_back(make_unique<MultilevelQueueScheduler>(4, 1));
+        schedulers.push_back(make_unique<MultilevelFeedbackQueueScheduler>(1));
+        for (auto& scheduler : schedulers) {
+            scheduler->setTraceLevel(TRACE_NONE);
+            scheduler->setRetention(RETAIN_AGGREGATES);
+            for (const auto& p : workload) {
+                scheduler->addProcess(p);
+            }
+            scheduler->schedule();
+            
+            const PhaseProfile& profile = scheduler->getPhaseProfile();
+            cout << left << setw(24) << scheduler->getName() << right << fixed << setprecision(2);
+            for (int phase = 0; phase < PHASE_COUNT; phase++) {
+                cout << setw(12) << profile.cycles[phase] * cycleCounterNanos() / 1e6;
+            }
+            cout << endl;
+        }
+    }
+    cout << string(24 + 12 * PHASE_COUNT, '=') << "\n";
+    
     cout << "\nBenchmark completed successfully!\n" << endl;
     
     return 0;
@@ -0,0 +1,48 @@
+#ifndef ARRIVAL_ORDER_H
+#define ARRIVAL_ORDER_H
+
+#include "scheduler.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Arrival ordering for preloaded workloads.
+//
+// Processes are ordered by arrival time, ties in input order (a stable
+// sort). The sort runs on compact 8-byte (arrival, index) keys with an LSD
+// radix sort, one 11-bit digit per pass and only as many passes as the
+// arrival range needs; large inputs split each pass across threads.
+// Records are moved once, by the final gather.
+
+// True when arrival times never decrease
+bool isArrivalSorted(const std::vector<Process>& processes);
+
+// Indices of processes in stable arrival order; threads = 0 picks a count
+// from the input size and the hardware
+std::vector<uint32_t> arrivalOrder(const std::vector<Process>& processes, unsigned threads = 0);
+
+// FNV-1a over the input fields of every process, in order
+uint64_t workloadHash(const std::vector<Process>& processes);
+
+// workloadHash() one process at a time, for workloads that are streamed
+class WorkloadHasher {
+private:
+    uint64_t hash;
+    uint64_t processes;
+    
+    void mix(int value);
+    
+public:
+    WorkloadHasher();
+    void add(const Process& p);
+    uint64_t count() const;
+    uint64_t digest() const;
+};
+
+// The workload in stable arrival order, skipping the sort when it is
+// already ordered. Results are cached by content, so every scheduler given
+// the same workload shares one immutable copy for as long as any of them
+// holds it. Safe to call from several threads.
+std::shared_ptr<const std::vector<Process>> sortedWorkload(std::vector<Process> processes);
+
+#endif // ARRIVAL_ORDER_H
@@ -0,0 +1,103 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "scheduler.h"
+#include "result_columns.h"
+#include "topology.h"
+#include "trace_import.h"
+#include "workload_generator.h"
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Summary output formats for batch runs
+enum OutputFormat {
+    FORMAT_TABLE,
+    FORMAT_CSV,
+    FORMAT_JSON
+};
+
+// Options for the non-interactive (batch) mode of bin/scheduler
+struct BatchOptions {
+    std::string workloadPath;
+    bool generate;                        // synthesize instead of reading a file
+    WorkloadConfig generator;
+    std::string schedTracePath;           // import a kernel scheduler trace instead
+    TraceImportOptions schedTrace;
+    std::string emitPath;                 // write the synthetic workload and exit
+    std::string spillPrefix;              // per-run result files (streamed runs)
+    std::string checkpointPrefix;         // per-run snapshots; resumed when present
+    int checkpointInterval;               // simulated time units between snapshots
+    int branchTime;                       // what-if fork time; -1 = independent runs
+    bool useTopology;                     // simulate a multi-CPU machine
+    TopologyOptions topology;
+    std::vector<std::string> algorithms;  // rr, pp, npp, mlq, mlfq
+    std::vector<int> quanta;              // one run per quantum for rr/mlq
+    std::string predictor;                // burst predictor for sjf/pmlfq (see makeBurstPredictor)
+    int contextSwitch;
+    TraceLevel trace;
+    OutputFormat format;
+    std::string outputPath;               // empty = standard output
+    std::string phaseProfilePath;         // per-run phase timings as JSON; needs PROFILE=1
+    std::string cacheDir;                 // reuse results of identical runs; empty = off
+    uint64_t advisePrefix;                // policy advisor: processes per candidate; 0 = off
+    std::string objective;                // what the advisor minimizes (see policy_advisor.h)
+    int dashboardFps;                     // live dashboard on stderr; 0 = off
+    std::string breakdownPath;            // per-run metrics breakdowns; empty = off
+    
+    BatchOptions();
+};
+
+// Aggregate outcome of one scheduler run
+struct RunResult {
+    std::string algorithm;
+    int quantum;                          // 0 when not applicable
+    size_t numProcesses;
+    double avgWaiting;
+    double avgTurnaround;
+    double avgResponse;
+    long long p95Turnaround;
+    int makespan;
+    double wallTimeMs;
+    int cpus;                             // 0 = single CPU without a topology model
+    uint64_t migrations;
+    uint64_t cacheMisses;
+    uint64_t contextSwitches;
+    long long switchTime;                 // simulated time spent switching, all CPUs
+    bool adaptiveQuantum;                 // adaptive Round Robin run
+    std::string predictor;                // burst predictor; empty when burstTime is read
+    double predictionMae;                 // mean absolute prediction error
+    double predictionBias;                // mean signed error (positive = overestimates)
+    double oracleWaiting;                 // same policy with known bursts; < 0 = not run
+    PhaseProfile phases;                  // empty unless built with SCHEDULER_PROFILING
+    bool cached;                          // read from the result cache, not simulated
+    std::shared_ptr<const MetricsBreakdown> breakdown;  // with --breakdown only
+};
+
+// Returns false and sets error on invalid arguments
+bool parseBatchArgs(int argc, char** argv, BatchOptions& options, std::string& error);
+void printBatchUsage(std::ostream& out, const char* program);
+
+// Creates a scheduler by short name; returns nullptr for unknown names.
+// Policies that plan with burst lengths get the predictor named by spec.
+std::unique_ptr<Scheduler> makeScheduler(const std::string& algorithm, int quantum, int contextSwitch,
+                                         const std::string& predictor = "exp");
+bool algorithmUsesQuantum(const std::string& algorithm);
+bool algorithmUsesPredictor(const std::string& algorithm);
+// True when each run re-reads its workload instead of being given it:
+// --generate, and --sched-trace from a file (standard input is read once)
+bool streamsWorkload(const BatchOptions& options);
+RunResult summarizeRun(const Scheduler& scheduler, int quantum, double wallTimeMs);
+RunResult summarizeRun(const TopologySimulator& machine, int quantum, double wallTimeMs);
+RunResult summarizeTrace(const TraceImportStats& trace, bool topology, double wallTimeMs);
+
+std::vector<RunResult> runBatch(const BatchOptions& options, const std::vector<Process>& workload);
+void writeResults(std::ostream& out, const std::vector<RunResult>& results, OutputFormat format);
+void writePhaseProfiles(std::ostream& out, const std::vector<RunResult>& results);
+void writeBreakdowns(std::ostream& out, const std::vector<RunResult>& results);
+
+// Entry point for batch mode; returns the process exit code
+int batchMain(int argc, char** argv);
+
+#endif // BATCH_H
@@ -0,0 +1,102 @@
+#ifndef BENCHMARK_BASELINE_H
+#define BENCHMARK_BASELINE_H
+
+#include "scheduler.h"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Benchmark baselines, for catching scheduler performance regressions.
+//
+// The regression suite of bin/benchmark times schedule() several times per
+// policy and workload size and records what the simulation produced. A
+// baseline file keeps both, and a later run is compared with it case by
+// case. Timings are compared with a two-sided Mann-Whitney U test, which
+// assumes nothing about the skewed, outlier-prone shape of timing
+// distributions; a case is slower only when the difference is significant
+// and its median moved by more than the noise floor. The simulation is
+// deterministic, so its outcome must match exactly; any difference is drift.
+//
+// Shared machines change speed between runs by tens of percent. The suite
+// therefore also times a fixed calibration task that does not depend on
+// this code; when both runs have it, current timings are scaled by the
+// ratio of its medians before they are compared.
+
+// Bump when the file layout changes; other versions fail to load
+const uint32_t BENCHMARK_BASELINE_VERSION = 1;
+
+// Name of the calibration case; its outcome is not compared
+const char* const CALIBRATION_CASE = "calibration";
+
+// What one run simulated; integer totals, so equality is exact
+struct SimulatedOutcome {
+    uint64_t completed;
+    int makespan;
+    uint64_t contextSwitches;
+    long long switchTime;
+    long long waiting;                       // sums over completed processes
+    long long turnaround;
+    long long response;
+    
+    bool operator==(const SimulatedOutcome& other) const = default;
+    std::string differences(const SimulatedOutcome& other) const;  // names of fields that differ
+};
+
+SimulatedOutcome outcomeOf(const Scheduler& scheduler);
+
+// One policy on one workload size
+struct BenchmarkCase {
+    std::string algorithm;                   // batch short name (rr, mlfq, ...)
+    uint64_t processes;
+    SimulatedOutcome outcome;
+    std::vector<double> samplesMs;           // wall time of schedule(), one per sample
+    
+    double medianMs() const;
+};
+
+void saveBaseline(std::ostream& out, const std::vector<BenchmarkCase>& cases);
+// Throws std::runtime_error on a malformed file or another version
+std::vector<BenchmarkCase> loadBaseline(std::istream& in);
+
+// Two-sided p-value that a and b come from the same distribution (normal
+// approximation with tie and continuity corrections)
+double mannWhitneyPValue(const std::vector<double>& a, const std::vector<double>& b);
+
+enum TimingVerdict {
+    TIMING_UNCHANGED,
+    TIMING_FASTER,
+    TIMING_SLOWER,
+    TIMING_NEW                               // not in the baseline
+};
+
+struct CaseComparison {
+    std::string algorithm;
+    uint64_t processes;
+    double baselineMs;                       // medians
+    double currentMs;
+    double change;                           // relative change of the median
+    double pValue;
+    TimingVerdict timing;
+    std::string drift;                       // outcome fields that differ; empty = identical
+    
+    bool failed() const;                     // slower or drifted
+};
+
+struct BaselineComparison {
+    double machineFactor;                    // current / baseline calibration median; 1 = none
+    std::vector<CaseComparison> cases;       // without the calibration case
+};
+
+// Every current case against the baseline case of the same policy and size.
+// alpha is the significance level, minChange the smallest relative change
+// of the median that counts.
+BaselineComparison compareToBaseline(const std::vector<BenchmarkCase>& baseline,
+                                     const std::vector<BenchmarkCase>& current,
+                                     double alpha = 0.01, double minChange = 0.05);
+
+// Table of all cases; returns the number that failed
+size_t writeComparison(std::ostream& out, const BaselineComparison& comparison);
+
+#endif // BENCHMARK_BASELINE_H
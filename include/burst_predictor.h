@@ -0,0 +1,98 @@
+#ifndef BURST_PREDICTOR_H
+#define BURST_PREDICTOR_H
+
+#include "metrics.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class Process;
+class CheckpointWriter;
+class CheckpointReader;
+
+// Burst-length prediction for policies that must not read burstTime.
+//
+// A real kernel only learns how long a CPU burst was once it has ended, so
+// predictors see a process's input fields when it arrives (predict()) and
+// its actual burst only when it completes (observe()). Every process is one
+// burst here, so history is kept per priority class rather than per task.
+// Both calls are O(1).
+class BurstPredictor {
+public:
+    static const int CLASSES = 6;       // priorities 0-5; others share the last class
+    
+    virtual ~BurstPredictor() {}
+    
+    virtual double predict(const Process& p) const = 0;
+    virtual void observe(const Process& p) = 0;
+    virtual std::string describe() const = 0;
+    virtual bool isOracle() const;
+    
+    // Learned state, for checkpoints
+    virtual void save(CheckpointWriter& out) const = 0;
+    virtual void load(CheckpointReader& in) = 0;
+
+protected:
+    static int classOf(const Process& p);
+};
+
+// Reads burstTime: the reference that predicted runs are compared against
+class OraclePredictor : public BurstPredictor {
+public:
+    double predict(const Process& p) const override;
+    void observe(const Process& p) override;
+    std::string describe() const override;
+    bool isOracle() const override;
+    void save(CheckpointWriter& out) const override;
+    void load(CheckpointReader& in) override;
+};
+
+// Exponential averaging per class: tau' = alpha * burst + (1 - alpha) * tau,
+// starting from initialGuess
+class ExponentialAveragePredictor : public BurstPredictor {
+private:
+    double alpha;
+    double estimates[CLASSES];
+
+public:
+    explicit ExponentialAveragePredictor(double alpha = 0.5, double initialGuess = 10.0);
+    double predict(const Process& p) const override;
+    void observe(const Process& p) override;
+    std::string describe() const override;
+    void save(CheckpointWriter& out) const override;
+    void load(CheckpointReader& in) override;
+};
+
+// A running quantile of each class's burst distribution (P-square, so no
+// samples are stored); initialGuess until the class has completed a burst
+class ClassQuantilePredictor : public BurstPredictor {
+private:
+    double quantile;
+    double initialGuess;
+    StreamingQuantile estimates[CLASSES];
+
+public:
+    explicit ClassQuantilePredictor(double quantile = 0.5, double initialGuess = 10.0);
+    double predict(const Process& p) const override;
+    void observe(const Process& p) override;
+    std::string describe() const override;
+    void save(CheckpointWriter& out) const override;
+    void load(CheckpointReader& in) override;
+};
+
+// "oracle", "exp[:ALPHA]" or "quantile[:Q]"; nullptr for anything else
+std::unique_ptr<BurstPredictor> makeBurstPredictor(const std::string& spec);
+
+// Accuracy of the predictions made for completed processes
+struct PredictionError {
+    uint64_t count;
+    double absoluteSum;
+    double signedSum;               // positive = bursts overestimated
+    
+    PredictionError();
+    void add(double predicted, long long actual);
+    double meanAbsolute() const;
+    double bias() const;
+};
+
+#endif // BURST_PREDICTOR_H
@@ -0,0 +1,70 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Process;
+
+// Binary simulation snapshots. Values are written in host byte order, so a
+// checkpoint is meant to be resumed on the machine (or architecture) that
+// wrote it. Queues refer to processes by slot index: both sides bind the
+// saved slots in the same order, then write/read references as indices.
+
+// Bump when the layout changes; older snapshots are rejected
+const uint32_t CHECKPOINT_VERSION = 7;
+
+class CheckpointWriter {
+private:
+    std::ostream& out;
+    std::unordered_map<const Process*, uint32_t> slotIndex;
+    
+public:
+    explicit CheckpointWriter(std::ostream& stream);
+    
+    void writeU32(uint32_t value);
+    void writeU64(uint64_t value);
+    void writeI32(int32_t value);
+    void writeI64(int64_t value);
+    void writeDouble(double value);
+    void writeString(const std::string& value);
+    void writeProcess(const Process& p);
+    
+    // Slot references (nullptr is written as an invalid index)
+    void bindSlot(const Process* p);
+    void writeSlot(const Process* p);
+    void writeSlots(const std::deque<Process*>& queue);
+    void writeSlots(const std::vector<Process*>& queue);
+};
+
+// Throws std::runtime_error on truncated or inconsistent input
+class CheckpointReader {
+private:
+    std::istream& in;
+    std::vector<Process*> slots;
+    
+    void readBytes(void* data, size_t size);
+    
+public:
+    explicit CheckpointReader(std::istream& stream);
+    
+    uint32_t readU32();
+    uint64_t readU64();
+    int32_t readI32();
+    int64_t readI64();
+    double readDouble();
+    std::string readString();
+    void readProcess(Process& p);
+    
+    void bindSlot(Process* p);
+    Process* readSlot();
+    void readSlots(std::deque<Process*>& queue);
+    void readSlots(std::vector<Process*>& queue);
+};
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,60 @@
+#ifndef COROUTINE_TASK_H
+#define COROUTINE_TASK_H
+
+#include "executor.h"
+#include <coroutine>
+
+// Coroutine task for the executor. The body runs as a C++20 coroutine and
+// marks its preemption points with `co_await yieldPoint()`; control returns
+// to the worker only when the policy says the task should yield (quantum
+// expired, or a higher-priority task is waiting), so a yield point that
+// does not preempt costs one clock read.
+//
+//     PreemptibleTask crunch(int chunks) {
+//         for (int i = 0; i < chunks; i++) {
+//             work(i);
+//             co_await yieldPoint();
+//         }
+//     }
+//     submitTask(executor, crunch(1000), priority);
+class PreemptibleTask {
+public:
+    struct promise_type {
+        PreemptibleTask get_return_object();
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception();
+    };
+    
+    using Handle = std::coroutine_handle<promise_type>;
+    
+private:
+    Handle handle;
+    
+public:
+    explicit PreemptibleTask(Handle h);
+    PreemptibleTask(PreemptibleTask&& other) noexcept;
+    PreemptibleTask& operator=(PreemptibleTask&& other) noexcept;
+    PreemptibleTask(const PreemptibleTask&) = delete;
+    PreemptibleTask& operator=(const PreemptibleTask&) = delete;
+    ~PreemptibleTask();
+    
+    // Runs to the next preemption; returns true once the body has finished
+    bool resume();
+    bool done() const;
+};
+
+// Awaitable preemption point; never suspends outside an executor worker
+struct YieldPoint {
+    bool await_ready() const noexcept;
+    void await_suspend(std::coroutine_handle<>) const noexcept {}
+    void await_resume() const noexcept {}
+};
+
+YieldPoint yieldPoint();
+
+// Submits a coroutine task; the executor's policy, quanta and metrics apply
+int submitTask(TaskExecutor& executor, PreemptibleTask task, int priority = 0);
+
+#endif // COROUTINE_TASK_H
@@ -0,0 +1,103 @@
+#ifndef DASHBOARD_H
+#define DASHBOARD_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <thread>
+
+// Live terminal view of a running simulation.
+//
+// The simulation never prints or blocks for the dashboard. Once per frame
+// the dashboard thread asks for a snapshot; the simulation notices the
+// request at the end of its next tick (one relaxed atomic load per tick),
+// copies a few counters into a SchedulerSnapshot and hands it over through
+// a triple buffer. The dashboard then redraws from that copy at its own
+// fixed frame rate, so watching a run costs the simulation one small copy
+// per frame rather than console output per tick.
+
+// Scheduler state at the end of one tick; plain data so it copies cheaply
+struct SchedulerSnapshot {
+    static const int MAX_LEVELS = 3;
+    
+    int time;
+    int runningPid;                          // -1 = idle
+    int runningRemaining;
+    int levels;                              // ready queue levels in use
+    const char* levelNames[MAX_LEVELS];      // string literals
+    uint64_t levelLengths[MAX_LEVELS];
+    uint64_t totalProcesses;
+    uint64_t admitted;
+    uint64_t completed;
+    long long busyTime;                      // time a process was on the CPU
+    long long totalWaiting;
+    long long totalTurnaround;
+    long long totalResponse;
+    uint64_t contextSwitches;
+    long long switchTime;
+    
+    SchedulerSnapshot();
+};
+
+// Single-producer, single-consumer triple buffer. The producer fills
+// back(), then publish() swaps it with the shared middle buffer; the
+// consumer swaps the middle buffer with its front buffer whenever a newer
+// one is there. Neither side ever waits for the other.
+class SnapshotChannel {
+private:
+    static const unsigned FRESH = 4;         // set in middle when unread
+    
+    SchedulerSnapshot buffers[3];
+    std::atomic<unsigned> middle;
+    unsigned backIndex;                      // producer side
+    unsigned frontIndex;                     // consumer side
+    std::atomic<bool> requested;
+
+public:
+    SnapshotChannel();
+    
+    // Producer (simulation thread)
+    bool wanted() const { return requested.load(std::memory_order_relaxed); }
+    SchedulerSnapshot& back();
+    void publish();
+    
+    // Consumer (dashboard thread)
+    void request();
+    bool latest(SchedulerSnapshot& out);     // false when nothing newer was published
+};
+
+class Dashboard {
+private:
+    std::ostream& out;
+    std::chrono::microseconds framePeriod;
+    SnapshotChannel channel;
+    std::thread renderer;
+    std::atomic<bool> running;
+    std::string title;
+    uint64_t frames;
+    
+    // Previous frame, for rates and rolling metrics
+    SchedulerSnapshot previous;
+    std::chrono::steady_clock::time_point previousWall;
+    bool hasPrevious;
+    
+    void renderLoop();
+    void render(const SchedulerSnapshot& now);
+
+public:
+    Dashboard(std::ostream& out, int framesPerSecond);
+    ~Dashboard();
+    
+    // Pass to Scheduler::setSnapshotChannel() before start()
+    SnapshotChannel& getChannel();
+    
+    // Starts redrawing; title names the run being watched
+    void start(const std::string& title);
+    // Draws a last frame from the latest snapshot and joins the thread
+    void stop();
+    uint64_t getFrames() const;              // frames drawn; read after stop()
+};
+
+#endif // DASHBOARD_H
@@ -0,0 +1,137 @@
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include "scheduler.h"
+#include "metrics.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Policy used to order real tasks on the executor's workers
+enum ExecutorPolicy {
+    EXEC_ROUND_ROBIN,   // one FIFO level, fixed quantum
+    EXEC_PRIORITY,      // levels 0-5 by priority, yields when a higher level is waiting
+    EXEC_MLFQ           // levels 0-2, quantum doubles per level, demotion on expiry
+};
+
+class TaskExecutor;
+
+// Handed to a task body on every dispatch
+class TaskContext {
+    friend class TaskExecutor;
+    
+private:
+    TaskExecutor* executor;
+    size_t worker;
+    int taskId;
+    int level;
+    std::chrono::steady_clock::time_point deadline;
+    
+public:
+    // Cooperative yield point: true once the task should return control
+    bool shouldYield() const;
+    int getTaskId() const;
+    int getLevel() const;
+};
+
+// A resumable task body: does a slice of work, returns true when finished or
+// false (typically after shouldYield()) to be requeued by the policy
+using TaskBody = std::function<bool(TaskContext&)>;
+
+// Measured outcome of executor runs, in microseconds
+struct ExecutorReport {
+    MetricsAggregate metrics;   // waiting / turnaround / response per task
+    size_t completedTasks;
+    size_t dispatches;
+    size_t steals;
+    double wallSeconds;
+    double throughput;          // completed tasks per second
+    double switchCostMicros;    // mean gap between slices on a busy worker
+};
+
+// Runs CPU-bound task closures on a pool of worker threads. Each worker owns
+// one deque per policy level; idle workers steal from the back of another
+// worker's highest non-empty level. Every finished task is recorded as a
+// Process (arrival, burst = CPU time used, start, completion, ...) so real
+// runs can be compared directly with the simulators.
+class TaskExecutor {
+    friend class TaskContext;
+    
+private:
+    struct Task {
+        TaskBody body;
+        Process record;
+        int level;
+        int64_t arrivalMicros;                  // durations are measured from this, not record times
+        int64_t cpuMicros;                      // CPU time so far; record.burstTime saturates
+    };
+    
+    struct alignas(64) Worker {
+        std::mutex lock;
+        std::vector<std::deque<Task*>> levels;
+        std::atomic<size_t> queued;
+        std::unique_ptr<std::atomic<size_t>[]> levelCounts;
+        std::chrono::steady_clock::time_point lastSliceEnd;   // owner thread only
+        bool busy;
+        
+        explicit Worker(size_t levelCount);
+    };
+    
+    ExecutorPolicy policy;
+    int quantumMicros;
+    size_t levelCount;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    std::chrono::steady_clock::time_point epoch;
+    std::chrono::steady_clock::time_point firstStart;
+    
+    std::atomic<int> nextTaskId;
+    std::atomic<size_t> nextWorker;
+    std::atomic<size_t> outstanding;
+    std::atomic<size_t> queuedTotal;
+    std::atomic<size_t> dispatchCount;
+    std::atomic<size_t> stealCount;
+    std::atomic<long long> switchNanos;
+    std::atomic<size_t> switchSamples;
+    std::atomic<bool> stopping;
+    bool running;
+    
+    std::mutex sleepLock;
+    std::condition_variable sleepSignal;
+    std::mutex doneLock;
+    std::condition_variable doneSignal;
+    std::vector<Process> completedRecords;
+    MetricsAggregate aggregate;
+    size_t completedTasks;
+    int64_t lastCompletion;
+    
+    int64_t now() const;                        // microseconds since construction
+    int levelFor(int priority) const;
+    int quantumFor(int level) const;
+    void push(size_t worker, Task* task);
+    Task* popLocal(size_t worker);
+    Task* steal(size_t thief);
+    void dispatch(size_t worker, Task* task);
+    void workerLoop(size_t worker);
+    bool higherLevelWaiting(size_t worker, int level) const;
+    
+public:
+    TaskExecutor(ExecutorPolicy pol, size_t workerCount, int quantum = 1000);
+    ~TaskExecutor();
+    
+    // Thread-safe; tasks submitted before start() wait until it is called
+    int submit(TaskBody body, int priority = 0);
+    void start();
+    void waitIdle();    // starts the workers if needed
+    void shutdown();
+    
+    size_t drainCompleted(std::vector<Process>& out);
+    ExecutorReport report();
+};
+
+#endif // EXECUTOR_H
@@ -0,0 +1,88 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Process;
+class CheckpointWriter;
+class CheckpointReader;
+
+// Streaming summary of one integer metric: O(1) update, constant memory.
+// Percentiles come from a log-linear histogram (16 sub-buckets per power
+// of two), so they are exact below 16 and within 1/16 relative error above.
+class StreamingStat {
+private:
+    static const int SUB_BUCKETS = 16;
+    static const int BUCKET_COUNT = SUB_BUCKETS + 60 * SUB_BUCKETS;
+    
+    uint64_t count;
+    long long sum;
+    double sumSquares;
+    long long minimum;
+    long long maximum;
+    std::vector<uint64_t> buckets;
+    
+    static int bucketIndex(long long value);
+    static long long bucketValue(int index);
+    
+public:
+    StreamingStat();
+    
+    void add(long long value);
+    void addAll(const int32_t* values, size_t count);   // as add() on each, in bulk
+    void merge(const StreamingStat& other);
+    
+    uint64_t getCount() const;
+    long long getSum() const;
+    double getMean() const;
+    double getStdDev() const;
+    long long getMin() const;
+    long long getMax() const;
+    long long getPercentile(double fraction) const;
+    
+    // Only non-empty histogram buckets are written
+    void save(CheckpointWriter& out) const;
+    void load(CheckpointReader& in);
+};
+
+// Running estimate of one quantile with the P-square algorithm (Jain and
+// Chlamtac): five markers, O(1) update and no stored samples. Exact until
+// five values have been seen.
+class StreamingQuantile {
+private:
+    double quantile;
+    uint64_t count;
+    double heights[5];
+    double positions[5];
+    double desired[5];
+    double increments[5];
+    
+    double parabolic(int i, int direction) const;
+    double linear(int i, int direction) const;
+    
+public:
+    explicit StreamingQuantile(double quantile = 0.5);
+    
+    void add(double value);
+    uint64_t getCount() const;
+    double get() const;                 // 0 before the first value
+    
+    void save(CheckpointWriter& out) const;
+    void load(CheckpointReader& in);
+};
+
+// Per-run aggregates of completed processes
+struct MetricsAggregate {
+    StreamingStat waiting;
+    StreamingStat turnaround;
+    StreamingStat response;
+    
+    void add(const Process& p);
+    void merge(const MetricsAggregate& other);
+    void save(CheckpointWriter& out) const;
+    void load(CheckpointReader& in);
+};
+
+#endif // METRICS_H
@@ -0,0 +1,92 @@
+#ifndef PHASE_PROFILER_H
+#define PHASE_PROFILER_H
+
+#include <cstdint>
+#include <ostream>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+// Phase profiler for the simulation loop. Each tick is split into the phases
+// below and timed with the CPU timestamp counter (steady_clock elsewhere).
+// The timers are compiled in only when SCHEDULER_PROFILING is defined (build
+// with `make PROFILE=1`); otherwise PROFILE_PHASE expands to nothing and
+// every profile stays empty. The Scheduler layout is the same either way, so
+// objects built with and without the flag can be linked together.
+
+enum SchedulerPhase {
+    PHASE_ADMIT,        // arrival intake
+    PHASE_RETIRE,       // completion accounting
+    PHASE_REQUEUE,      // quantum expiry and demotion
+    PHASE_SELECT,       // picking and dispatching the next process
+    PHASE_VISUALIZE,    // per-tick tracing
+    PHASE_CHECKPOINT,   // periodic snapshots
+    PHASE_COUNT
+};
+
+const char* phaseName(SchedulerPhase phase);
+
+// True when the library was built with SCHEDULER_PROFILING
+bool phaseProfilingEnabled();
+
+inline uint64_t readCycleCounter() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Nanoseconds per readCycleCounter() unit, calibrated once per process
+double cycleCounterNanos();
+
+// Accumulated cycles and entries per phase
+struct PhaseProfile {
+    uint64_t cycles[PHASE_COUNT];
+    uint64_t calls[PHASE_COUNT];
+    uint64_t ticks;
+    
+    PhaseProfile();
+    void merge(const PhaseProfile& other);
+    uint64_t totalCycles() const;
+    
+    // Table with per-phase time, share and cost per call
+    void writeReport(std::ostream& out) const;
+    // {"ticks": N, "phases": {"admit": {"calls": N, "ns": N}, ...}}
+    void writeJson(std::ostream& out) const;
+};
+
+#ifdef SCHEDULER_PROFILING
+class PhaseTimer {
+private:
+    PhaseProfile& profile;
+    SchedulerPhase phase;
+    uint64_t calls;
+    uint64_t start;
+
+public:
+    PhaseTimer(PhaseProfile& target, SchedulerPhase timed, uint64_t count = 1)
+        : profile(target), phase(timed), calls(count), start(readCycleCounter()) {}
+    ~PhaseTimer() {
+        profile.cycles[phase] += readCycleCounter() - start;
+        profile.calls[phase] += calls;
+    }
+};
+
+#define PROFILE_PHASE_CONCAT(a, b) a##b
+#define PROFILE_PHASE_NAME(line) PROFILE_PHASE_CONCAT(phaseTimer, line)
+#define PROFILE_PHASE(profile, phase) PhaseTimer PROFILE_PHASE_NAME(__LINE__)(profile, phase)
+// One timed span standing for several entries of the phase
+#define PROFILE_PHASE_CALLS(profile, phase, count) \
+    PhaseTimer PROFILE_PHASE_NAME(__LINE__)(profile, phase, count)
+#define PROFILE_TICK(profile) ((profile).ticks++)
+#else
+#define PROFILE_PHASE(profile, phase) ((void)0)
+#define PROFILE_PHASE_CALLS(profile, phase, count) ((void)0)
+#define PROFILE_TICK(profile) ((void)0)
+#endif
+
+#endif // PHASE_PROFILER_H
@@ -0,0 +1,69 @@
+#ifndef POLICY_ADVISOR_H
+#define POLICY_ADVISOR_H
+
+#include "batch.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Policy advisor: recommends a scheduling policy for a workload without
+// simulating every policy on all of it.
+//
+// One streaming pass characterizes the whole workload (arrival rate and
+// burstiness, burst distribution, priority mix) while keeping only its
+// first prefixProcesses arrivals. Once the prefix is complete, every
+// candidate policy, with quanta drawn from the prefix's burst distribution,
+// runs on it concurrently, one thread each, while the pass continues; the
+// candidates are then ranked by the objective. The prefix keeps the real
+// arrival pattern; a sampled subset would thin the arrivals and understate
+// the load. Metrics of a prefix are estimates: its queues drain at the end
+// without the arrivals that follow.
+
+// Single-pass workload characterization; O(1) per process, constant memory
+struct WorkloadProfile {
+    static const int PRIORITY_CLASSES = 6;   // 0-5; others count as 5
+    
+    uint64_t processes;
+    int firstArrival;
+    int lastArrival;
+    StreamingStat bursts;
+    StreamingStat gaps;                      // inter-arrival times
+    uint64_t priorities[PRIORITY_CLASSES];
+    
+    WorkloadProfile();
+    void add(const Process& p);              // in arrival order
+    double arrivalRate() const;              // arrivals per time unit
+    double offeredLoad() const;              // CPU demand per time unit; > 1 = overloaded
+    void write(std::ostream& out) const;
+};
+
+// One candidate: the batch options that select it, and its prefix result
+struct AdvisorCandidate {
+    std::string algorithm;
+    int quantum;
+    std::string predictor;                   // burst predictor spec; empty unless sjf/pmlfq
+    RunResult result;
+    
+    std::string flags() const;               // e.g. "-a rr -q 8", "-a sjf --predictor exp"
+};
+
+struct AdvisorReport {
+    WorkloadProfile profile;
+    uint64_t prefixProcesses;                // simulated per candidate
+    std::string objective;
+    std::vector<AdvisorCandidate> candidates;  // best first
+    double profileMs;                        // the whole characterization pass
+    double simulateMs;                       // from the prefix to the last candidate
+};
+
+bool isAdvisorObjective(const std::string& objective);   // waiting|turnaround|response|p95
+
+// Throws std::runtime_error when the workload is empty
+AdvisorReport adviseWorkload(const BatchOptions& options, const std::vector<Process>& workload);
+
+// The table format adds the profile and the recommendation; CSV and JSON
+// hold the ranked candidates only, the recommendation first
+void writeAdvice(std::ostream& out, const AdvisorReport& report, OutputFormat format);
+
+#endif // POLICY_ADVISOR_H
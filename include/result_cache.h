@@ -0,0 +1,52 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include "arrival_order.h"
+#include "batch.h"
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Content-addressed on-disk cache of finished batch runs.
+//
+// A run is described by a key string: the workload's content hash (or, for
+// a synthetic workload, its generator settings) plus every option that can
+// change the outcome. The entry file is named by a hash of that key and
+// repeats the key, so a hash collision reads as a miss. Each entry holds
+// the summary row (<hash>.run) and, when the run produced them, the
+// per-process results (<hash>.csv, in the columns of a spill file).
+
+// Bump when simulation results change; entries of other versions are misses
+const uint32_t RESULT_CACHE_VERSION = 5;
+
+// Identifies the workload a batch will run (computed once per batch)
+std::string workloadKey(const BatchOptions& options, const std::vector<Process>& workload);
+
+// Identifies one algorithm/quantum run of that workload
+std::string runKey(const std::string& workload, const std::string& algorithm, int quantum,
+                   const BatchOptions& options);
+
+class ResultCache {
+private:
+    std::string directory;
+    
+    std::string entryPath(const std::string& key, const char* extension) const;
+    void writeSummary(const std::string& key, const RunResult& result, bool hasRows) const;
+
+public:
+    // Creates the directory when missing; throws std::runtime_error
+    explicit ResultCache(const std::string& directory);
+    
+    // Fills result on a hit. With rowsPath, the per-process results are
+    // copied there as well, and an entry without them is a miss.
+    bool load(const std::string& key, RunResult& result, const std::string& rowsPath = "") const;
+    
+    // Stores a run with the per-process results already written to
+    // rowsPath (a spill file), or with none when rowsPath is empty
+    void store(const std::string& key, const RunResult& result, const std::string& rowsPath = "") const;
+    // Stores a run with the retained processes of a materialized run
+    void store(const std::string& key, const RunResult& result, const std::deque<Process>& processes) const;
+};
+
+#endif // RESULT_CACHE_H
@@ -9,7 +9,18 @@
 #include <iomanip>
 #include <string>
 #include <memory>
-#include <map>
+#include <unordered_map>
+#include <fstream>
+#include <climits>
+#include "metrics.h"
+#include "phase_profiler.h"
+#include "burst_predictor.h"
+
+class CheckpointWriter;
+class CheckpointReader;
+class SnapshotChannel;
+struct SchedulerSnapshot;
+struct ResultColumns;
 
 // Process states
 enum ProcessState {
@@ -20,6 +31,20 @@ enum ProcessState {
     TERMINATED
 };
 
+// What happens to a process once it terminates
+enum RetentionMode {
+    RETAIN_ALL,         // stays resident (schedule() default)
+    RETAIN_RECORDS,     // handed out by drainCompleted(), slot reused (online default)
+    RETAIN_AGGREGATES   // folded into the run aggregates only, slot reused
+};
+
+// Console tracing levels for schedule()
+enum TraceLevel {
+    TRACE_NONE,     // No output; fastest path for batch runs
+    TRACE_SUMMARY,  // Banner and final metrics only
+    TRACE_FULL      // Per-tick queue visualization (interactive default)
+};
+
 // Process Control Block
 class Process {
 public:
@@ -40,16 +65,147 @@ public:
     void display() const;
 };
 
+// Submitted process waiting for its arrival time (online mode)
+struct PendingArrival {
+    Process process;
+    unsigned long long sequence;
+};
+
+// Orders pending arrivals by arrival time, then submission order
+struct LaterArrival {
+    bool operator()(const PendingArrival& a, const PendingArrival& b) const {
+        if (a.process.arrivalTime == b.process.arrivalTime) {
+            return a.sequence > b.sequence;
+        }
+        return a.process.arrivalTime > b.process.arrivalTime;
+    }
+};
+
+// Extra simulated time charged when a process is dispatched, on top of the
+// fixed context switch cost: cache refills, migrations, remote memory. Called
+// for every dispatch, including the first and a re-dispatch of the process
+// that just ran; see topology.h for the multi-CPU cost model.
+class DispatchCostModel {
+public:
+    virtual ~DispatchCostModel() {}
+    virtual int dispatchPenalty(const Process& next) = 0;
+    virtual void processRetired(const Process&) {}
+};
+
 // Base Scheduler class
+//
+// The simulation advances one tick at a time through runTick(); subclasses
+// supply the policy through the protected queue hooks. schedule() runs the
+// workload given to addProcess() to completion. The incremental API
+// (submit/step/advanceUntil/drainCompleted) drives the same engine from a
+// live feed: completed processes are handed out as records and their slots
+// reused, so memory stays proportional to the processes in flight.
+// RETAIN_AGGREGATES goes further and keeps only streaming aggregates of the
+// finished processes (optionally spilling each one to a result file).
+//
+// The preloaded workload is put in arrival order by start() (a cached,
+// shared copy; see arrival_order.h) and never modified after that;
+// admitted processes are copied into slots. saveState()/loadState()
+// snapshot the slots and queues needed to continue a run bit-for-bit, but
+// not the workload itself: resume into a fresh scheduler of the same kind
+// after re-adding the same workload, so snapshot size follows the admitted
+// and pending processes rather than the length of the trace. branchFrom()
+// forks a running simulation the same way, sharing the workload.
 class Scheduler {
 protected:
-    std::vector<Process> processes;
+    std::vector<Process> staged;        // addProcess() before start()
+    std::shared_ptr<const std::vector<Process>> workload;  // arrival order; shared
+    std::deque<Process> processes;      // admitted slots; deque keeps queue pointers stable
+    std::vector<Process*> freeSlots;    // retired slots reused in online mode
+    std::priority_queue<PendingArrival, std::vector<PendingArrival>, LaterArrival> pendingArrivals;
+    std::vector<Process> completedRecords;
+    Process* currentProcess;
+    int timeSlice;
+    size_t nextArrival;
+    size_t preloadedProcesses;
+    mutable uint64_t workloadDigest;    // workloadHash(*workload) once computed
+    mutable bool workloadDigested;
+    size_t totalProcesses;
+    size_t admittedProcesses;
+    unsigned long long submissionSequence;
+    bool started;
+    RetentionMode retention;
+    std::unique_ptr<std::ofstream> spillFile;
+    std::string spillPath;
+    std::string checkpointPath;
+    int checkpointInterval;             // simulated time units; 0 = off
+    int nextCheckpoint;
+    MetricsAggregate aggregate;
     int currentTime;
     int contextSwitchTime;
-    int totalWaitingTime;
-    int totalTurnaroundTime;
-    int totalResponseTime;
+    DispatchCostModel* costModel;       // not owned; nullptr = fixed costs only
+    long long totalWaitingTime;
+    long long totalTurnaroundTime;
+    long long totalResponseTime;
+    size_t contextSwitches;
+    long long switchTime;               // simulated time spent switching
+    long long busyTime;                 // simulated time a process was on the CPU
     size_t completedProcesses;
+    int makespan;
+    TraceLevel traceLevel;
+    bool fastForwardEnabled;
+    PhaseProfile profile;               // stays empty unless built with SCHEDULER_PROFILING
+    std::unique_ptr<BurstPredictor> predictor;      // nullptr = policies read burstTime
+    std::unordered_map<const Process*, double> predictedBursts; // by slot, made at admission
+    PredictionError predictionError;
+    SnapshotChannel* snapshots;         // not owned; nullptr = no live view
+    ResultColumns* resultColumns;       // not owned; nullptr = no columnar results
+    
+    // Simulation engine
+    void start();
+    void enterOnlineMode();
+    void run();
+    void runTick(int horizon = INT_MAX);
+    void fastForward(int horizon);
+    void admitArrivals();
+    Process* claimSlot(const Process& arrival);
+    void retire(Process* p);
+    void chargeContextSwitch();
+    void skipIdle(int limit);
+    bool hasWork() const;
+    bool hasPendingArrival() const;
+    int nextArrivalTime() const;
+    void checkpointIfDue();
+    uint64_t workloadFingerprint() const;
+    void saveEngine(CheckpointWriter& out) const;
+    void loadEngine(CheckpointReader& in);
+    
+    // The burst a policy may plan with: the prediction made when p was
+    // admitted, or burstTime when no predictor is installed
+    double expectedBurst(const Process* p);
+    
+    // Policy hooks
+    virtual void enqueue(Process* p) = 0;
+    virtual Process* selectNext() = 0;
+    virtual bool hasReady() const = 0;
+    virtual void traceTick() = 0;
+    virtual void onArrival(Process* p);
+    virtual bool quantumExpired() const;
+    virtual void onQuantumExpired(Process* p);
+    virtual void onRetire(Process* p);
+    
+    // Fast-forward hook: when the current process and the ready processes in
+    // cycle (in dispatch order) just rotate with a fixed quantum, returns
+    // that quantum; 0 when the policy is not in such a steady state
+    virtual int steadyRotation(const std::deque<Process*>*& cycle) const;
+    
+    // Checkpoint hooks: ready queues are saved as slot references
+    virtual void saveQueues(CheckpointWriter& out) const = 0;
+    virtual void loadQueues(CheckpointReader& in) = 0;
+    
+    // Ready processes in dispatch order (hands the ready set to another policy)
+    virtual void collectReady(std::vector<Process*>& out) const = 0;
+    virtual void removeReady(Process* p) = 0;
+    
+    // Ready queue lengths per level, for the live dashboard
+    virtual void countReady(SchedulerSnapshot& out) const = 0;
+    // Level (as numbered by countReady) of a process about to retire
+    virtual int levelOf(const Process* p) const;
     
 public:
     Scheduler(int contextSwitch = 1);
@@ -57,38 +213,232 @@ public:
     
     void addProcess(const Process& p);
     virtual void schedule() = 0;
+    virtual std::string getName() const = 0;
+    void setTraceLevel(TraceLevel level);
+    void setRetention(RetentionMode mode);
+    void setSpillFile(const std::string& path);
+    void setDispatchCostModel(DispatchCostModel* model);
+    void setFastForward(bool enabled);
+    void setBurstPredictor(std::unique_ptr<BurstPredictor> model);
+    
+    // Live view (see dashboard.h): a snapshot is published at the end of
+    // the first tick after each request, or on demand by publishSnapshot()
+    void setSnapshotChannel(SnapshotChannel* channel);
+    void publishSnapshot();
+    
+    // Columnar results (see result_columns.h): every process that finishes
+    // from now on is appended to columns, and displayMetrics() adds the
+    // breakdown. Not part of checkpoints.
+    void setResultColumns(ResultColumns* columns);
     void displayMetrics();
     void visualizeQueue(const std::deque<Process*>& readyQueue, Process* running);
     void displayProcessStates();
     
+    // Incremental (online) simulation
+    void submit(const Process& p);
+    bool step();
+    void advanceUntil(int time);
+    size_t drainCompleted(std::vector<Process>& out);
+    
+    // Migration: takes the ready process this policy would dispatch last out
+    // of the run, as if it had never been submitted here. Returns false when
+    // nothing is waiting. Needs a retention mode that reuses slots.
+    bool detachReady(Process& out);
+    
+    // Checkpoint and resume; loading throws std::runtime_error on a
+    // mismatched or corrupt snapshot, after which the scheduler is unusable
+    void setCheckpoint(const std::string& path, int interval);
+    void saveCheckpoint(const std::string& path);
+    void restoreCheckpoint(const std::string& path);
+    void saveState(std::ostream& out);
+    void loadState(std::istream& in);
+    
+    // What-if branching: continue source's run from its current state under
+    // this scheduler's policy and parameters. Must be called on a scheduler
+    // that has not run and has no workload of its own. The same policy
+    // inherits the exact queues; another policy gets the running and ready
+    // processes re-enqueued in the source's dispatch order.
+    void branchFrom(Scheduler& source);
+    
     // Getters for testing
     double getAverageWaitingTime() const;
     double getAverageTurnaroundTime() const;
     double getAverageResponseTime() const;
+    size_t getProcessCount() const;
+    size_t getCompletedCount() const;
+    size_t getInFlightCount() const;
+    int getCurrentTime() const;
+    int getMakespan() const;
+    size_t getContextSwitchCount() const;
+    long long getSwitchTime() const;
+    size_t getResidentCount() const;
+    const MetricsAggregate& getAggregate() const;
+    const PhaseProfile& getPhaseProfile() const;
+    const BurstPredictor* getBurstPredictor() const;
+    const PredictionError& getPredictionError() const;
+    const std::deque<Process>& getRetainedProcesses() const;  // every process under RETAIN_ALL
 };
 
 // Round Robin Scheduler
 class RoundRobinScheduler : public Scheduler {
-private:
+protected:
+    std::deque<Process*> readyQueue;
     int timeQuantum;
     
+protected:
+    void enqueue(Process* p) override;
+    Process* selectNext() override;
+    bool hasReady() const override;
+    void traceTick() override;
+    bool quantumExpired() const override;
+    int steadyRotation(const std::deque<Process*>*& cycle) const override;
+    void saveQueues(CheckpointWriter& out) const override;
+    void loadQueues(CheckpointReader& in) override;
+    void collectReady(std::vector<Process*>& out) const override;
+    void removeReady(Process* p) override;
+    void countReady(SchedulerSnapshot& out) const override;
+    
 public:
     RoundRobinScheduler(int quantum, int contextSwitch = 1);
     void schedule() override;
+    std::string getName() const override;
+};
+
+// Limits of the adaptive Round Robin quantum
+struct AdaptiveQuantum {
+    int minQuantum;
+    int maxQuantum;
+    int targetLatency;          // time for the whole ready queue to get a turn
+    double burstQuantile;       // quantile of completed bursts the quantum follows
+    double maxSwitchOverhead;   // largest share of a slice spent switching; 0 = no floor
+    
+    AdaptiveQuantum();
+};
+
+// Round Robin whose quantum is recomputed at every dispatch: the running
+// burstQuantile of completed bursts (a P-square estimate), so most bursts
+// finish in one slice, capped so the ready queue turns over within
+// targetLatency. The quantum never drops below what keeps the context
+// switch cost within maxSwitchOverhead of a slice (nor below minQuantum).
+// The configured quantum applies until the first process completes.
+class AdaptiveRoundRobinScheduler : public RoundRobinScheduler {
+private:
+    AdaptiveQuantum limits;
+    StreamingQuantile bursts;
+    int currentQuantum;
+    
+protected:
+    Process* selectNext() override;
+    bool quantumExpired() const override;
+    int steadyRotation(const std::deque<Process*>*& cycle) const override;
+    void onRetire(Process* p) override;
+    void saveQueues(CheckpointWriter& out) const override;
+    void loadQueues(CheckpointReader& in) override;
+    
+public:
+    AdaptiveRoundRobinScheduler(int initialQuantum, const AdaptiveQuantum& limits, int contextSwitch = 1);
+    void schedule() override;
+    std::string getName() const override;
+    int getCurrentQuantum() const;
+};
+
+// Ready-queue ordering for the priority schedulers: lower number first,
+// earlier arrival breaks ties
+struct PriorityOrder {
+    bool operator()(const Process* a, const Process* b) const {
+        if (a->priority == b->priority) {
+            return a->arrivalTime > b->arrivalTime;
+        }
+        return a->priority > b->priority;
+    }
+};
+
+// Priority ready queue whose heap array can be saved and restored verbatim,
+// so equal-priority ties pop in the same order after a resume
+class PriorityReadyQueue : public std::priority_queue<Process*, std::vector<Process*>, PriorityOrder> {
+public:
+    std::vector<Process*>& heap() { return c; }
+    const std::vector<Process*>& heap() const { return c; }
 };
 
 // Priority Scheduler (Preemptive)
 class PreemptivePriorityScheduler : public Scheduler {
+private:
+    PriorityReadyQueue readyQueue;
+    
+protected:
+    void enqueue(Process* p) override;
+    Process* selectNext() override;
+    bool hasReady() const override;
+    void traceTick() override;
+    void onArrival(Process* p) override;
+    void saveQueues(CheckpointWriter& out) const override;
+    void loadQueues(CheckpointReader& in) override;
+    void collectReady(std::vector<Process*>& out) const override;
+    void removeReady(Process* p) override;
+    void countReady(SchedulerSnapshot& out) const override;
+    
 public:
     PreemptivePriorityScheduler(int contextSwitch = 1);
     void schedule() override;
+    std::string getName() const override;
 };
 
 // Non-Preemptive Priority Scheduler
 class NonPreemptivePriorityScheduler : public Scheduler {
+private:
+    PriorityReadyQueue readyQueue;
+    
+protected:
+    void enqueue(Process* p) override;
+    Process* selectNext() override;
+    bool hasReady() const override;
+    void traceTick() override;
+    void saveQueues(CheckpointWriter& out) const override;
+    void loadQueues(CheckpointReader& in) override;
+    void collectReady(std::vector<Process*>& out) const override;
+    void removeReady(Process* p) override;
+    void countReady(SchedulerSnapshot& out) const override;
+    
 public:
     NonPreemptivePriorityScheduler(int contextSwitch = 1);
     void schedule() override;
+    std::string getName() const override;
+};
+
+// Orders the shortest-job-first heap: shortest expected burst first, then
+// arrival time and pid, so ties pop the same way after a resume
+struct ShorterJob {
+    bool operator()(const std::pair<double, Process*>& a, const std::pair<double, Process*>& b) const {
+        if (a.first != b.first) return a.first > b.first;
+        if (a.second->arrivalTime != b.second->arrivalTime) {
+            return a.second->arrivalTime > b.second->arrivalTime;
+        }
+        return a.second->pid > b.second->pid;
+    }
+};
+
+// Shortest Job First (Non-Preemptive), ordered by expectedBurst(): the
+// textbook oracle without a predictor, an SJF approximation with one
+class ShortestJobFirstScheduler : public Scheduler {
+private:
+    std::vector<std::pair<double, Process*>> readyHeap;
+    
+protected:
+    void enqueue(Process* p) override;
+    Process* selectNext() override;
+    bool hasReady() const override;
+    void traceTick() override;
+    void saveQueues(CheckpointWriter& out) const override;
+    void loadQueues(CheckpointReader& in) override;
+    void collectReady(std::vector<Process*>& out) const override;
+    void removeReady(Process* p) override;
+    void countReady(SchedulerSnapshot& out) const override;
+    
+public:
+    ShortestJobFirstScheduler(int contextSwitch = 1);
+    void schedule() override;
+    std::string getName() const override;
 };
 
 // Multilevel Queue Scheduler
@@ -99,24 +449,64 @@ private:
     std::deque<Process*> batchQueue;
     int timeQuantum;
     
+    // Queue for a priority: 0 = system (0-1), 1 = interactive (2-3), 2 = batch
+    static int bandOf(const Process* p);
+    
+protected:
+    void enqueue(Process* p) override;
+    Process* selectNext() override;
+    bool hasReady() const override;
+    void traceTick() override;
+    bool quantumExpired() const override;
+    int steadyRotation(const std::deque<Process*>*& cycle) const override;
+    void saveQueues(CheckpointWriter& out) const override;
+    void loadQueues(CheckpointReader& in) override;
+    void collectReady(std::vector<Process*>& out) const override;
+    void removeReady(Process* p) override;
+    void countReady(SchedulerSnapshot& out) const override;
+    int levelOf(const Process* p) const override;
+    
 public:
     MultilevelQueueScheduler(int quantum, int contextSwitch = 1);
     void schedule() override;
+    std::string getName() const override;
 };
 
 // Multilevel Feedback Queue Scheduler
+//
+// Arrivals start in Q0. With a burst predictor they start at the level
+// whose cumulative quantum first covers the predicted burst instead, so
+// long jobs skip the demotions they would otherwise pay for.
 class MultilevelFeedbackQueueScheduler : public Scheduler {
 private:
     std::deque<Process*> queue0;
     std::deque<Process*> queue1;
     std::deque<Process*> queue2;
-    std::map<int, int> processQueue;
-    int quantum0 = 8;
-    int quantum1 = 16;
+    std::unordered_map<const Process*, int> processQueue;  // by slot; pids may repeat
+    int quantum0;
+    int quantum1;
+    int currentQueueLevel;
+    
+protected:
+    void enqueue(Process* p) override;
+    void onArrival(Process* p) override;
+    Process* selectNext() override;
+    bool hasReady() const override;
+    void traceTick() override;
+    bool quantumExpired() const override;
+    void onQuantumExpired(Process* p) override;
+    void onRetire(Process* p) override;
+    void saveQueues(CheckpointWriter& out) const override;
+    void loadQueues(CheckpointReader& in) override;
+    void collectReady(std::vector<Process*>& out) const override;
+    void removeReady(Process* p) override;
+    void countReady(SchedulerSnapshot& out) const override;
+    int levelOf(const Process* p) const override;
     
 public:
-    MultilevelFeedbackQueueScheduler(int contextSwitch = 1);
+    MultilevelFeedbackQueueScheduler(int contextSwitch = 1, int firstQuantum = 8, int secondQuantum = 16);
     void schedule() override;
+    std::string getName() const override;
 };
 
 #endif // SCHEDULER_H
\ No newline at end of file
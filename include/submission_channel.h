@@ -0,0 +1,65 @@
+#ifndef SUBMISSION_CHANNEL_H
+#define SUBMISSION_CHANNEL_H
+
+#include "scheduler.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Compact arrival record carried through the channel
+struct Submission {
+    int pid;
+    int arrivalTime;
+    int burstTime;
+    int priority;
+};
+
+// Lock-free multi-producer, single-consumer channel for feeding a running
+// simulation from several ingest threads (e.g. one per trace shard).
+//
+// Each producer owns a bounded single-producer/single-consumer ring, so
+// pushes never contend with each other. Producers must push their own
+// arrivals in non-decreasing arrival order; the consumer merges the rings
+// and releases an arrival only once every open producer has something
+// buffered (or has closed), which yields exact global arrival order.
+// A full ring applies backpressure: push() waits until the consumer
+// catches up.
+class SubmissionChannel {
+private:
+    struct alignas(64) Lane {
+        std::unique_ptr<Submission[]> slots;
+        size_t mask;
+        alignas(64) std::atomic<size_t> head;   // consumer position
+        size_t cachedTail;                      // consumer's view of tail
+        alignas(64) std::atomic<size_t> tail;   // producer position
+        size_t cachedHead;                      // producer's view of head
+        std::atomic<bool> closed;
+        
+        explicit Lane(size_t capacity);
+    };
+    
+    std::vector<std::unique_ptr<Lane>> lanes;
+    
+    const Submission* peek(Lane& lane);
+    
+public:
+    // Capacity per producer is rounded up to a power of two
+    SubmissionChannel(size_t producers, size_t capacityPerProducer = 4096);
+    
+    // Producer side: each index must be used by a single thread
+    bool tryPush(size_t producer, const Process& p);
+    void push(size_t producer, const Process& p);
+    void close(size_t producer);
+    
+    // Consumer side
+    bool tryPop(Process& out);
+    bool finished();
+    size_t producerCount() const;
+    
+    // Submits every arrival that is next in global order, advancing the
+    // scheduler's clock to each arrival first. Returns the number submitted.
+    size_t feed(Scheduler& scheduler);
+};
+
+#endif // SUBMISSION_CHANNEL_H
@@ -0,0 +1,141 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include "scheduler.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Multi-CPU simulation over a described machine.
+//
+// Each logical CPU runs its own single-CPU scheduler (per-CPU run queues, as
+// in Linux), all advanced in lockstep. Arrivals are placed on a CPU by the
+// placement policy and a periodic balancer migrates waiting processes off
+// overloaded CPUs. On top of the fixed context switch cost, every dispatch
+// pays for the caches it finds cold and for running away from the NUMA node
+// that holds its memory; warmth follows which processes ran recently on each
+// core and socket. SMT siblings share their core's caches but are otherwise
+// independent CPUs (execution-unit contention is not modelled).
+
+// Machine layout: sockets (one NUMA node each) x cores x SMT threads.
+// Logical CPUs are numbered socket-major, so the siblings of a core are adjacent.
+enum CpuDistance {
+    SAME_CPU,
+    SMT_SIBLING,
+    SAME_SOCKET,
+    REMOTE_SOCKET
+};
+
+struct CpuTopology {
+    int sockets;
+    int coresPerSocket;
+    int threadsPerCore;
+    
+    CpuTopology(int sockets = 1, int cores = 1, int threads = 1);
+    
+    // "SxCxT", e.g. "2x8x2"; throws std::invalid_argument
+    static CpuTopology parse(const std::string& spec);
+    
+    int cpuCount() const;
+    int coreOf(int cpu) const;          // machine-wide core index
+    int socketOf(int cpu) const;
+    CpuDistance distance(int from, int to) const;
+    std::string describe() const;
+};
+
+// Dispatch penalties in simulated time units. A process is warm on a core
+// while it is among the last coreCacheProcesses to run there (private
+// L1/L2, shared by SMT siblings) and warm on a socket while among the last
+// socketCacheProcesses to run on it (shared LLC). Its memory lives on the
+// socket where it first ran.
+struct CacheCosts {
+    int coreMiss;               // core caches cold, LLC warm
+    int llcMiss;                // cold everywhere
+    int remoteMemory;           // running off the process's home socket
+    int coreCacheProcesses;
+    int socketCacheProcesses;
+    
+    CacheCosts();
+};
+
+// Where arrivals go and how far the balancer may move them
+enum PlacementPolicy {
+    PLACE_LEAST_LOADED,     // topology-blind: the least loaded CPU anywhere
+    PLACE_SMT_AWARE,        // idle physical cores before SMT siblings; balance to the nearest CPU
+    PLACE_NUMA_LOCAL        // like SMT_AWARE, but only cross sockets on a large imbalance
+};
+
+struct TopologyOptions {
+    CpuTopology topology;
+    CacheCosts costs;
+    PlacementPolicy placement;
+    int balanceInterval;        // simulated time between balancer passes
+    int remoteImbalance;        // PLACE_NUMA_LOCAL: load gap that justifies a cross-socket move
+    
+    TopologyOptions();
+};
+
+struct TopologyCounters {
+    uint64_t dispatches;
+    uint64_t smtMigrations;     // dispatched on a sibling of the CPU it last ran on
+    uint64_t coreMigrations;    // another core of the same socket
+    uint64_t socketMigrations;  // another socket
+    uint64_t coreMisses;
+    uint64_t llcMisses;
+    uint64_t remoteDispatches;
+    long long penaltyTime;
+    
+    TopologyCounters();
+    uint64_t migrations() const;
+    uint64_t cacheMisses() const;
+};
+
+class TopologyCostModel;
+
+class TopologySimulator {
+    friend class TopologyCostModel;
+    
+public:
+    using SchedulerFactory = std::function<std::unique_ptr<Scheduler>()>;
+    
+private:
+    struct CacheState;
+    
+    TopologyOptions options;
+    std::vector<std::unique_ptr<Scheduler>> cpus;
+    std::unique_ptr<CacheState> cache;
+    std::vector<std::unique_ptr<TopologyCostModel>> models;
+    int nextBalance;
+    int nextAdmission;
+    
+    size_t load(int cpu) const;
+    int place() const;
+    int balanceTarget(int from) const;
+    void balance();
+    void advanceAll(int time);
+    
+public:
+    // One scheduler per logical CPU, all built by factory
+    TopologySimulator(const TopologyOptions& options, const SchedulerFactory& factory);
+    ~TopologySimulator();
+    
+    // Arrival times must not decrease. The CPUs see the process under a
+    // fresh admission id, since workload pids need not be unique.
+    void submit(const Process& p);
+    void finish();
+    
+    std::string getName() const;
+    int getCpuCount() const;
+    const Scheduler& getCpu(int cpu) const;
+    size_t getProcessCount() const;
+    size_t getCompletedCount() const;
+    int getMakespan() const;
+    MetricsAggregate getAggregate() const;
+    PhaseProfile getPhaseProfile() const;  // summed over CPUs
+    const TopologyCounters& getCounters() const;
+    void displayMetrics() const;
+};
+
+#endif // TOPOLOGY_H
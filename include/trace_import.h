@@ -0,0 +1,109 @@
+#ifndef TRACE_IMPORT_H
+#define TRACE_IMPORT_H
+
+#include "scheduler.h"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+// Import of kernel scheduler traces: ftrace text output (the trace file or
+// `trace-cmd report`) and `perf script` output of sched:sched_switch and
+// sched:sched_wakeup events, in either the key=value or the compact
+// "comm:pid [prio] S ==> comm:pid [prio]" form. Binary perf.data and
+// trace.dat files are read by piping those tools into "-".
+//
+// Every wakeup-to-block interval of a task becomes one Process: it arrives
+// at the wakeup and its burst is the CPU time it got before it slept. The
+// time it then spent blocked is an I/O wait (only uninterruptible D sleeps
+// count). Replay is open-loop: a task's next burst arrives when the kernel
+// woke it, however long the simulated previous burst took. Pids are
+// renumbered 1, 2, ... in arrival order because a task yields many bursts.
+// The kernel's own waiting, turnaround and response times for each burst are
+// collected as well, so simulated runs can be compared against the kernel.
+
+struct TraceImportOptions {
+    int tickMicros;                 // trace microseconds per simulated time unit
+    size_t maxHeldBursts;           // completed bursts held behind an open one before it is split
+    
+    TraceImportOptions();
+};
+
+struct TraceImportStats {
+    uint64_t lines;
+    uint64_t events;                // parsed sched_switch and sched_wakeup lines
+    uint64_t bursts;
+    uint64_t truncatedBursts;       // still runnable when the trace ended
+    uint64_t splitBursts;           // cut so later bursts could be handed out
+    uint64_t ioWaits;
+    long long ioWaitTime;           // simulated time units
+    uint64_t migrations;            // kernel moved a task to another CPU
+    int cpus;
+    int makespan;                   // last burst completion, simulated time
+    MetricsAggregate kernel;        // what the kernel delivered, per burst
+    
+    TraceImportStats();
+};
+
+// Streaming parser: feed() takes any chunking of the text, finish() closes
+// the bursts still open. Bursts reach the sink in arrival order once every
+// earlier arrival has completed. A burst that stays open while more than
+// maxHeldBursts completed ones wait behind it (a task that never sleeps) is
+// cut at the current time and continues as a new burst, so memory follows
+// the runnable tasks and that bound, not the trace length.
+class TraceImporter {
+public:
+    using Sink = std::function<void(const Process&)>;
+
+private:
+    struct Burst {
+        int64_t arrival;
+        int64_t firstRun;
+        int64_t runStart;
+        int64_t cpuTime;
+        int64_t end;
+        int pid;
+        int priority;
+        bool done;
+    };
+    struct Task {
+        uint64_t burst;             // sequence of the open burst, or NO_BURST
+        int64_t blockedAt;
+        int lastCpu;
+        bool ioWait;
+    };
+    
+    TraceImportOptions options;
+    Sink sink;
+    TraceImportStats stats;
+    std::unordered_map<int, Task> tasks;
+    std::deque<Burst> open;         // front has sequence firstSequence
+    uint64_t firstSequence;
+    int64_t origin;
+    int64_t lastTimestamp;
+    int nextPid;
+    std::string carry;              // partial line between feed() calls
+    
+    void parseLine(const char* begin, const char* end);
+    void onWakeup(int64_t time, int pid, int prio);
+    void onSwitch(int64_t time, int cpu, int prevPid, char prevState, int nextPid, int nextPrio);
+    Burst* openBurst(Task& task, int pid, int64_t time, int prio);
+    void splitFront();
+    void flush();
+    int64_t ticks(int64_t micros) const;
+
+public:
+    TraceImporter(const TraceImportOptions& options, Sink sink);
+    
+    void feed(const char* data, size_t size);
+    void finish();
+    const TraceImportStats& getStats() const;
+};
+
+// Imports a trace file through a read-only mapping ("-" streams standard
+// input); throws std::runtime_error when the file cannot be read
+TraceImportStats importTrace(const std::string& path, const TraceImportOptions& options,
+                             const TraceImporter::Sink& sink);
+
+#endif // TRACE_IMPORT_H
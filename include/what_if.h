@@ -0,0 +1,22 @@
+#ifndef WHAT_IF_H
+#define WHAT_IF_H
+
+#include "batch.h"
+#include <ostream>
+#include <vector>
+
+// What-if analysis: replay a workload once up to a branch time, then fork
+// the simulation into every other configuration of the batch options and
+// finish the baseline and all branches concurrently, one thread each.
+//
+// The baseline is the first algorithm with its first quantum; every other
+// algorithm/quantum combination becomes a branch. Branches share the
+// immutable workload (and, for --generate, replay a copy of the generator
+// from the branch point), so the prefix is simulated exactly once.
+// Returns the baseline first, then the branches in option order.
+std::vector<RunResult> runWhatIf(const BatchOptions& options, const std::vector<Process>& workload);
+
+// Side-by-side deltas of each branch against the baseline (first result)
+void writeComparison(std::ostream& out, const std::vector<RunResult>& results);
+
+#endif // WHAT_IF_H
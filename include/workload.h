@@ -0,0 +1,26 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include "scheduler.h"
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Workload files are plain text, one process per line:
+//   pid,arrival,burst[,priority]
+// Fields may also be separated by whitespace. Blank lines, lines starting
+// with '#' and a leading "pid,..." header line are ignored.
+
+// Parses a workload stream; throws std::runtime_error on malformed input
+std::vector<Process> readWorkload(std::istream& in);
+
+// Loads a workload file ("-" reads standard input)
+std::vector<Process> loadWorkload(const std::string& path);
+
+// Writes processes in the format accepted by readWorkload()
+void writeWorkload(std::ostream& out, const std::vector<Process>& processes);
+void writeWorkloadHeader(std::ostream& out);
+void writeWorkloadLine(std::ostream& out, const Process& p);
+
+#endif // WORKLOAD_H
@@ -0,0 +1,79 @@
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include "scheduler.h"
+#include <cstdint>
+#include <vector>
+
+// xoshiro256** pseudo-random generator, seeded through splitmix64
+class FastRandom {
+private:
+    uint64_t state[4];
+    
+public:
+    explicit FastRandom(uint64_t seed);
+    uint64_t next();
+    double nextDouble();       // uniform in [0, 1)
+    double nextOpenDouble();   // uniform in (0, 1)
+};
+
+// Inter-arrival process
+enum ArrivalPattern {
+    ARRIVAL_POISSON,   // exponential inter-arrival times
+    ARRIVAL_BURSTY     // two-state modulated Poisson (bursts and lulls)
+};
+
+// CPU burst length distribution
+enum BurstDistribution {
+    BURST_EXPONENTIAL,
+    BURST_PARETO,      // heavy tail, shape = paretoShape
+    BURST_LOGNORMAL    // heavy tail, sigma = lognormalSigma
+};
+
+struct WorkloadConfig {
+    uint64_t count;                      // processes to generate
+    uint64_t seed;
+    ArrivalPattern arrivals;
+    double arrivalRate;                  // mean arrivals per time unit
+    double burstFactor;                  // rate multiplier inside a burst (bursty only)
+    double meanPhaseLength;              // mean arrivals per burst/lull phase
+    BurstDistribution bursts;
+    double meanBurst;
+    double paretoShape;                  // must be > 1 for a finite mean
+    double lognormalSigma;
+    int maxBurst;                        // bursts are clamped to [1, maxBurst]
+    std::vector<double> priorityWeights; // relative weight of priority 0, 1, ...
+    
+    WorkloadConfig();
+};
+
+// Lazily produces processes with non-decreasing arrival times, so arbitrarily
+// large workloads can be streamed without being materialized.
+class WorkloadGenerator {
+private:
+    WorkloadConfig config;
+    FastRandom random;
+    std::vector<double> priorityCdf;
+    uint64_t produced;
+    double clock;
+    bool inBurst;
+    double spareNormal;
+    bool hasSpareNormal;
+    
+    double nextInterArrival();
+    int nextBurst();
+    int nextPriority();
+    double nextNormal();
+    
+public:
+    explicit WorkloadGenerator(const WorkloadConfig& cfg);
+    
+    bool hasNext() const;
+    Process next();                          // throws std::runtime_error past INT_MAX arrival time
+    uint64_t generated() const;
+    
+    // Materializes up to limit processes (for workloads that fit in memory)
+    std::vector<Process> take(uint64_t limit);
+};
+
+#endif // WORKLOAD_GENERATOR_H
@@ -0,0 +1,223 @@
+// src/arrival_order.cpp
+// Radix sort of workloads by arrival time and the shared sorted-workload cache
+
+#include "arrival_order.h"
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+using namespace std;
+
+static const int RADIX_BITS = 11;
+static const size_t RADIX_SIZE = 1 << RADIX_BITS;
+static const size_t SMALL_INPUT = 256;           // comparison sort below this
+static const size_t PARALLEL_CHUNK = 1 << 18;    // keys per thread, at least
+
+// ============== Radix Sort ==============
+bool isArrivalSorted(const vector<Process>& processes) {
+    for (size_t i = 1; i < processes.size(); i++) {
+        if (processes[i].arrivalTime < processes[i - 1].arrivalTime) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// One stable counting pass over the digit at `shift`. Each thread counts
+// and scatters its own contiguous chunk; chunk-major offsets keep the pass
+// stable.
+static void radixPass(const vector<uint64_t>& from, vector<uint64_t>& to, int shift, unsigned threads) {
+    size_t n = from.size();
+    size_t chunk = (n + threads - 1) / threads;
+    vector<vector<size_t>> counts(threads, vector<size_t>(RADIX_SIZE, 0));
+    
+    auto count = [&](unsigned t) {
+        size_t end = min(n, (t + 1) * chunk);
+        for (size_t i = t * chunk; i < end; i++) {
+            counts[t][(from[i] >> shift) & (RADIX_SIZE - 1)]++;
+        }
+    };
+    auto scatter = [&](unsigned t, vector<size_t> offsets) {
+        size_t end = min(n, (t + 1) * chunk);
+        for (size_t i = t * chunk; i < end; i++) {
+            to[offsets[(from[i] >> shift) & (RADIX_SIZE - 1)]++] = from[i];
+        }
+    };
+    
+    vector<thread> workers;
+    for (unsigned t = 1; t < threads; t++) workers.emplace_back(count, t);
+    count(0);
+    for (auto& w : workers) w.join();
+    workers.clear();
+    
+    vector<vector<size_t>> offsets(threads, vector<size_t>(RADIX_SIZE));
+    size_t position = 0;
+    for (size_t digit = 0; digit < RADIX_SIZE; digit++) {
+        for (unsigned t = 0; t < threads; t++) {
+            offsets[t][digit] = position;
+            position += counts[t][digit];
+        }
+    }
+    
+    for (unsigned t = 1; t < threads; t++) workers.emplace_back(scatter, t, offsets[t]);
+    scatter(0, offsets[0]);
+    for (auto& w : workers) w.join();
+}
+
+vector<uint32_t> arrivalOrder(const vector<Process>& processes, unsigned threads) {
+    size_t n = processes.size();
+    if (n > UINT32_MAX) {
+        throw length_error("workload too large to order");
+    }
+    if (n == 0) return {};
+    
+    // Key = arrival (sign bit flipped so it orders as unsigned) in the high
+    // word, input index in the low word. Digits where no arrival differs
+    // from the first one need no pass.
+    vector<uint64_t> keys(n);
+    uint32_t first = (uint32_t)processes[0].arrivalTime ^ 0x80000000u;
+    uint32_t varying = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t arrival = (uint32_t)processes[i].arrivalTime ^ 0x80000000u;
+        varying |= arrival ^ first;
+        keys[i] = ((uint64_t)arrival << 32) | i;
+    }
+    
+    if (n < SMALL_INPUT) {
+        sort(keys.begin(), keys.end());
+    } else {
+        if (threads == 0) {
+            threads = max(1u, thread::hardware_concurrency());
+        }
+        threads = (unsigned)max<size_t>(1, min<size_t>(threads, n / PARALLEL_CHUNK + 1));
+        
+        vector<uint64_t> buffer(n);
+        for (int shift = 32; shift < 64; shift += RADIX_BITS) {
+            if (((varying >> (shift - 32)) & (RADIX_SIZE - 1)) == 0) continue;
+            radixPass(keys, buffer, shift, threads);
+            keys.swap(buffer);
+        }
+    }
+    
+    vector<uint32_t> order(n);
+    for (size_t i = 0; i < n; i++) {
+        order[i] = (uint32_t)keys[i];
+    }
+    return order;
+}
+
+// ============== Sorted Workload Cache ==============
+static bool sameProcess(const Process& a, const Process& b) {
+    return a.pid == b.pid && a.arrivalTime == b.arrivalTime && a.burstTime == b.burstTime &&
+           a.remainingTime == b.remainingTime && a.priority == b.priority &&
+           a.waitingTime == b.waitingTime && a.turnaroundTime == b.turnaroundTime &&
+           a.responseTime == b.responseTime && a.completionTime == b.completionTime &&
+           a.startTime == b.startTime && a.state == b.state && a.firstExecution == b.firstExecution;
+}
+
+WorkloadHasher::WorkloadHasher() : hash(1469598103934665603ULL), processes(0) {}
+
+void WorkloadHasher::mix(int value) {
+    hash ^= (uint32_t)value;
+    hash *= 1099511628211ULL;
+}
+
+void WorkloadHasher::add(const Process& p) {
+    mix(p.pid);
+    mix(p.arrivalTime);
+    mix(p.burstTime);
+    mix(p.priority);
+    processes++;
+}
+
+uint64_t WorkloadHasher::count() const {
+    return processes;
+}
+
+uint64_t WorkloadHasher::digest() const {
+    return hash ^ processes;
+}
+
+// One pass over the records: FNV-1a over the input fields, plus whether
+// the arrivals are already in order
+static uint64_t fingerprint(const vector<Process>& processes, bool& sorted) {
+    WorkloadHasher hasher;
+    sorted = true;
+    for (size_t i = 0; i < processes.size(); i++) {
+        hasher.add(processes[i]);
+        if (i > 0 && processes[i].arrivalTime < processes[i - 1].arrivalTime) {
+            sorted = false;
+        }
+    }
+    return hasher.digest();
+}
+
+uint64_t workloadHash(const vector<Process>& processes) {
+    bool sorted;
+    return fingerprint(processes, sorted);
+}
+
+// Keyed by a fingerprint of the unsorted input; a hit is verified against
+// the input through the stored order, so collisions cannot alias
+struct CachedWorkload {
+    weak_ptr<const vector<Process>> sorted;
+    vector<uint32_t> order;   // empty when the input was already sorted
+};
+
+static mutex cacheMutex;
+static unordered_multimap<uint64_t, CachedWorkload> cache;
+
+static bool matches(const CachedWorkload& entry, const vector<Process>& sorted,
+                    const vector<Process>& processes) {
+    if (sorted.size() != processes.size()) return false;
+    for (size_t i = 0; i < processes.size(); i++) {
+        size_t source = entry.order.empty() ? i : entry.order[i];
+        if (!sameProcess(sorted[i], processes[source])) return false;
+    }
+    return true;
+}
+
+shared_ptr<const vector<Process>> sortedWorkload(vector<Process> processes) {
+    bool presorted;
+    uint64_t key = fingerprint(processes, presorted);
+    
+    {
+        lock_guard<mutex> lock(cacheMutex);
+        auto range = cache.equal_range(key);
+        for (auto it = range.first; it != range.second;) {
+            shared_ptr<const vector<Process>> sorted = it->second.sorted.lock();
+            if (!sorted) {
+                it = cache.erase(it);
+                continue;
+            }
+            if (matches(it->second, *sorted, processes)) {
+                return sorted;
+            }
+            ++it;
+        }
+    }
+    
+    CachedWorkload entry;
+    shared_ptr<const vector<Process>> sorted;
+    if (presorted) {
+        sorted = make_shared<const vector<Process>>(move(processes));
+    } else {
+        entry.order = arrivalOrder(processes);
+        auto gathered = make_shared<vector<Process>>();
+        gathered->reserve(processes.size());
+        for (uint32_t index : entry.order) {
+            gathered->push_back(processes[index]);
+        }
+        sorted = gathered;
+    }
+    entry.sorted = sorted;
+    
+    lock_guard<mutex> lock(cacheMutex);
+    for (auto it = cache.begin(); it != cache.end();) {
+        it = it->second.sorted.expired() ? cache.erase(it) : next(it);
+    }
+    cache.emplace(key, move(entry));
+    return sorted;
+}
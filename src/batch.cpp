@@ -0,0 +1,977 @@
+// src/batch.cpp
+// Non-interactive batch mode: run a workload file through selected schedulers
+
+#include "batch.h"
+#include "arrival_order.h"
+#include "dashboard.h"
+#include "policy_advisor.h"
+#include "result_cache.h"
+#include "what_if.h"
+#include "workload.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+static const vector<string> ALL_ALGORITHMS = {"rr", "pp", "npp", "mlq", "mlfq"};
+
+BatchOptions::BatchOptions()
+    : generate(false), checkpointInterval(100000), branchTime(-1), useTopology(false),
+      algorithms(ALL_ALGORITHMS),
+      quanta({4}), predictor("exp"), contextSwitch(1), trace(TRACE_NONE), format(FORMAT_TABLE),
+      advisePrefix(0), objective("waiting"), dashboardFps(0) {}
+
+static vector<string> splitList(const string& value) {
+    vector<string> items;
+    stringstream ss(value);
+    string item;
+    while (getline(ss, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+static bool parseInt(const string& value, int minimum, int& result) {
+    try {
+        size_t used = 0;
+        result = stoi(value, &used);
+        return used == value.size() && result >= minimum;
+    } catch (const exception&) {
+        return false;
+    }
+}
+
+static bool parseCount(const string& value, uint64_t& result) {
+    try {
+        size_t used = 0;
+        result = stoull(value, &used);
+        return used == value.size() && value[0] != '-';
+    } catch (const exception&) {
+        return false;
+    }
+}
+
+static bool parsePositive(const string& value, double& result) {
+    try {
+        size_t used = 0;
+        result = stod(value, &used);
+        return used == value.size() && result > 0.0;
+    } catch (const exception&) {
+        return false;
+    }
+}
+
+void printBatchUsage(ostream& out, const char* program) {
+    out << "Usage: " << program << " [options]\n"
+        << "Runs without the interactive menu when any option is given.\n\n"
+        << "  -w, --workload FILE        Workload file (pid,arrival,burst[,priority]); '-' = stdin\n"
+        << "  -g, --generate N           Synthesize N processes instead of reading a workload\n"
+        << "      --seed S               Generator seed (default: 1)\n"
+        << "      --arrivals PATTERN     poisson|bursty (default: poisson)\n"
+        << "      --rate R               Mean arrivals per time unit (default: 0.08)\n"
+        << "      --bursts DIST          exponential|pareto|lognormal (default: lognormal)\n"
+        << "      --mean-burst B         Mean CPU burst (default: 10)\n"
+        << "      --sched-trace FILE     Replay a kernel trace (ftrace or perf script sched_switch/\n"
+        << "                             sched_wakeup text; '-' = stdin) and compare with the kernel\n"
+        << "      --sched-tick US        Trace microseconds per simulated time unit (default: 1000)\n"
+        << "      --emit-workload FILE   Stream the synthetic or imported workload to FILE ('-' = stdout)\n"
+        << "                             and exit\n"
+        << "      --spill PREFIX         With --generate, write each finished process to PREFIX-<run>.csv\n"
+        << "      --checkpoint PREFIX    Snapshot each run to PREFIX-<run>.ckpt; resume from it if present\n"
+        << "      --checkpoint-every T   Simulated time between snapshots (default: 100000)\n"
+        << "      --branch-at T          Run the first configuration to time T, then fork the others\n"
+        << "                             from that state and compare them side by side\n"
+        << "      --topology SxCxT       Simulate S sockets x C cores x T SMT threads, one run queue\n"
+        << "                             per CPU, with cache and NUMA dispatch penalties\n"
+        << "      --placement POLICY     least-loaded|smt|numa (default: smt)\n"
+        << "      --cache-penalties LIST Core miss, LLC miss, remote memory costs (default: 1,3,2)\n"
+        << "  -a, --algorithms LIST      Comma-separated: rr,pp,npp,mlq,mlfq or all (default: all);\n"
+        << "                             arr = Round Robin with an adaptive quantum, sjf = Shortest\n"
+        << "                             Job First and pmlfq = MLFQ placing arrivals by predicted burst\n"
+        << "  -q, --quantum LIST         Comma-separated quanta for rr/mlq (default: 4)\n"
+        << "      --predictor MODEL      Burst predictor for sjf/pmlfq: exp[:ALPHA] (exponential\n"
+        << "                             average), quantile[:Q] (per-priority running quantile) or\n"
+        << "                             oracle (known bursts); default: exp\n"
+        << "  -c, --context-switch N     Context switch cost (default: 1)\n"
+        << "  -t, --trace LEVEL          none|summary|full (default: none)\n"
+        << "      --dashboard FPS        Redraw a live view of each run on stderr FPS times a second\n"
+        << "  -f, --format FORMAT        table|csv|json (default: table)\n"
+        << "  -o, --output FILE          Write the summary to FILE instead of stdout\n"
+        << "      --cache DIR            Reuse results of identical runs stored in DIR (created if\n"
+        << "                             missing); new results are added to it\n"
+        << "      --advise N             Recommend a policy instead: profile the whole workload in one\n"
+        << "                             pass, then race every policy on its first N processes\n"
+        << "      --objective METRIC     What --advise minimizes: waiting|turnaround|response|p95\n"
+        << "                             (default: waiting)\n"
+        << "      --phase-profile FILE   Write per-run phase timings as JSON ('-' = stdout);\n"
+        << "                             needs a build with make PROFILE=1\n"
+        << "      --breakdown FILE       Write each run's metric distributions and averages by\n"
+        << "                             priority and queue level ('-' = stdout)\n"
+        << "  -h, --help                 Show this help\n";
+}
+
+bool parseBatchArgs(int argc, char** argv, BatchOptions& options, string& error) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        
+        if (arg == "-h" || arg == "--help") {
+            error = "help";
+            return false;
+        }
+        
+        if (i + 1 >= argc) {
+            error = "missing value for " + arg;
+            return false;
+        }
+        string value = argv[++i];
+        
+        if (arg == "-w" || arg == "--workload") {
+            options.workloadPath = value;
+        } else if (arg == "-g" || arg == "--generate") {
+            if (!parseCount(value, options.generator.count)) {
+                error = "invalid process count '" + value + "'";
+                return false;
+            }
+            options.generate = true;
+        } else if (arg == "--seed") {
+            if (!parseCount(value, options.generator.seed)) {
+                error = "invalid seed '" + value + "'";
+                return false;
+            }
+        } else if (arg == "--arrivals") {
+            if (value == "poisson") options.generator.arrivals = ARRIVAL_POISSON;
+            else if (value == "bursty") options.generator.arrivals = ARRIVAL_BURSTY;
+            else {
+                error = "invalid arrival pattern '" + value + "'";
+                return false;
+            }
+        } else if (arg == "--rate") {
+            if (!parsePositive(value, options.generator.arrivalRate)) {
+                error = "invalid arrival rate '" + value + "'";
+                return false;
+            }
+        } else if (arg == "--bursts") {
+            if (value == "exponential") options.generator.bursts = BURST_EXPONENTIAL;
+            else if (value == "pareto") options.generator.bursts = BURST_PARETO;
+            else if (value == "lognormal") options.generator.bursts = BURST_LOGNORMAL;
+            else {
+                error = "invalid burst distribution '" + value + "'";
+                return false;
+            }
+        } else if (arg == "--mean-burst") {
+            if (!parsePositive(value, options.generator.meanBurst)) {
+                error = "invalid mean burst '" + value + "'";
+                return false;
+            }
+        } else if (arg == "--sched-trace") {
+            options.schedTracePath = value;
+        } else if (arg == "--sched-tick") {
+            if (!parseInt(value, 1, options.schedTrace.tickMicros)) {
+                error = "invalid trace tick '" + value + "'";
+                return false;
+            }
+        } else if (arg == "--emit-workload") {
+            options.emitPath = value;
+        } else if (arg == "--spill") {
+            options.spillPrefix = value;
+        } else if (arg == "--checkpoint") {
+            options.checkpointPrefix = value;
+        } else if (arg == "--checkpoint-every") {
+            if (!parseInt(value, 1, options.checkpointInterval)) {
+                error = "invalid checkpoint interval '" + value + "'";
+                return false;
+            }
+        } else if (arg == "--branch-at") {
+            if (!parseInt(value, 0, options.branchTime)) {
+                error = "invalid branch time '" + value + "'";
+                return false;
+            }
+        } else if (arg == "--topology") {
+            try {
+                options.topology.topology = CpuTopology::parse(value);
+            } catch (const invalid_argument& e) {
+                error = e.what();
+                return false;
+            }
+            options.useTopology = true;
+        } else if (arg == "--placement") {
+            if (value == "least-loaded") options.topology.placement = PLACE_LEAST_LOADED;
+            else if (value == "smt") options.topology.placement = PLACE_SMT_AWARE;
+            else if (value == "numa") options.topology.placement = PLACE_NUMA_LOCAL;
+            else {
+                error = "invalid placement policy '" + value + "'";
+                return false;
+            }
+        } else if (arg == "--cache-penalties") {
+            vector<string> items = splitList(value);
+            CacheCosts& costs = options.topology.costs;
+            if (items.size() != 3 || !parseInt(items[0], 0, costs.coreMiss) ||
+                !parseInt(items[1], 0, costs.llcMiss) || !parseInt(items[2], 0, costs.remoteMemory)) {
+                error = "invalid cache penalties '" + value + "'";
+                return false;
+            }
+        } else if (arg == "-a" || arg == "--algorithms") {
+            options.algorithms.clear();
+            for (const auto& name : splitList(value)) {
+                if (name == "all") {
+                    options.algorithms = ALL_ALGORITHMS;
+                    break;
+                }
+                if (!makeScheduler(name, 1, 0)) {
+                    error = "unknown algorithm '" + name + "'";
+                    return false;
+                }
+                options.algorithms.push_back(name);
+            }
+        } else if (arg == "-q" || arg == "--quantum") {
+            options.quanta.clear();
+            for (const auto& item : splitList(value)) {
+                int quantum;
+                if (!parseInt(item, 1, quantum)) {
+                    error = "invalid quantum '" + item + "'";
+                    return false;
+                }
+                options.quanta.push_back(quantum);
+            }
+        } else if (arg == "--predictor") {
+            if (!makeBurstPredictor(value)) {
+                error = "invalid burst predictor '" + value + "'";
+                return false;
+            }
+            options.predictor = value;
+        } else if (arg == "-c" || arg == "--context-switch") {
+            if (!parseInt(value, 0, options.contextSwitch)) {
+                error = "invalid context switch cost '" + value + "'";
+                return false;
+            }
+        } else if (arg == "-t" || arg == "--trace") {
+            if (value == "none") options.trace = TRACE_NONE;
+            else if (value == "summary") options.trace = TRACE_SUMMARY;
+            else if (value == "full") options.trace = TRACE_FULL;
+            else {
+                error = "invalid trace level '" + value + "'";
+                return false;
+            }
+        } else if (arg == "--dashboard") {
+            if (!parseInt(value, 1, options.dashboardFps) || options.dashboardFps > 120) {
+                error = "invalid dashboard frame rate '" + value + "' (1-120)";
+                return false;
+            }
+        } else if (arg == "-f" || arg == "--format") {
+            if (value == "table") options.format = FORMAT_TABLE;
+            else if (value == "csv") options.format = FORMAT_CSV;
+            else if (value == "json") options.format = FORMAT_JSON;
+            else {
+                error = "invalid output format '" + value + "'";
+                return false;
+            }
+        } else if (arg == "-o" || arg == "--output") {
+            options.outputPath = value;
+        } else if (arg == "--cache") {
+            options.cacheDir = value;
+        } else if (arg == "--advise") {
+            if (!parseCount(value, options.advisePrefix) || options.advisePrefix == 0) {
+                error = "invalid advisor prefix '" + value + "'";
+                return false;
+            }
+        } else if (arg == "--objective") {
+            if (!isAdvisorObjective(value)) {
+                error = "invalid objective '" + value + "'";
+                return false;
+            }
+            options.objective = value;
+        } else if (arg == "--phase-profile") {
+            options.phaseProfilePath = value;
+        } else if (arg == "--breakdown") {
+            options.breakdownPath = value;
+        } else {
+            error = "unknown option " + arg;
+            return false;
+        }
+    }
+    
+    int sources = !options.workloadPath.empty() + options.generate + !options.schedTracePath.empty();
+    if (sources != 1) {
+        error = "give exactly one of --workload, --generate or --sched-trace";
+        return false;
+    }
+    if (!options.emitPath.empty() && !options.workloadPath.empty()) {
+        error = "--emit-workload requires --generate or --sched-trace";
+        return false;
+    }
+    if (!options.spillPrefix.empty() && !options.generate) {
+        error = "--spill requires --generate";
+        return false;
+    }
+    if (options.branchTime >= 0 && (!options.spillPrefix.empty() || !options.checkpointPrefix.empty() ||
+                                    !options.cacheDir.empty())) {
+        error = "--branch-at cannot be combined with --spill, --checkpoint or --cache";
+        return false;
+    }
+    if (options.useTopology && (options.branchTime >= 0 || !options.spillPrefix.empty() ||
+                                !options.checkpointPrefix.empty())) {
+        error = "--topology cannot be combined with --branch-at, --spill or --checkpoint";
+        return false;
+    }
+    if (options.advisePrefix > 0 && (options.branchTime >= 0 || options.useTopology || !options.spillPrefix.empty() ||
+                                     !options.checkpointPrefix.empty() || !options.cacheDir.empty())) {
+        error = "--advise cannot be combined with --branch-at, --topology, --spill, --checkpoint or --cache";
+        return false;
+    }
+    if (options.dashboardFps > 0 && (options.trace == TRACE_FULL || options.branchTime >= 0 ||
+                                     options.useTopology || options.advisePrefix > 0)) {
+        error = "--dashboard cannot be combined with --trace full, --branch-at, --topology or --advise";
+        return false;
+    }
+    if (!options.breakdownPath.empty() && (options.branchTime >= 0 || options.useTopology ||
+                                           options.advisePrefix > 0 || !options.checkpointPrefix.empty() ||
+                                           !options.cacheDir.empty())) {
+        error = "--breakdown cannot be combined with --branch-at, --topology, --advise, --checkpoint or --cache";
+        return false;
+    }
+    if (options.algorithms.empty() || options.quanta.empty()) {
+        error = "empty algorithm or quantum list";
+        return false;
+    }
+    if (!options.phaseProfilePath.empty() && !phaseProfilingEnabled()) {
+        error = "--phase-profile needs a profiling build (make PROFILE=1)";
+        return false;
+    }
+    return true;
+}
+
+unique_ptr<Scheduler> makeScheduler(const string& algorithm, int quantum, int contextSwitch,
+                                    const string& predictor) {
+    if (algorithmUsesPredictor(algorithm)) {
+        unique_ptr<Scheduler> scheduler;
+        if (algorithm == "sjf") {
+            scheduler = make_unique<ShortestJobFirstScheduler>(contextSwitch);
+        } else {
+            scheduler = make_unique<MultilevelFeedbackQueueScheduler>(contextSwitch);
+        }
+        unique_ptr<BurstPredictor> model = makeBurstPredictor(predictor);
+        if (!model) {
+            throw invalid_argument("invalid burst predictor '" + predictor + "'");
+        }
+        scheduler->setBurstPredictor(move(model));
+        return scheduler;
+    }
+    if (algorithm == "rr") return make_unique<RoundRobinScheduler>(quantum, contextSwitch);
+    if (algorithm == "arr") return make_unique<AdaptiveRoundRobinScheduler>(quantum, AdaptiveQuantum(), contextSwitch);
+    if (algorithm == "pp") return make_unique<PreemptivePriorityScheduler>(contextSwitch);
+    if (algorithm == "npp") return make_unique<NonPreemptivePriorityScheduler>(contextSwitch);
+    if (algorithm == "mlq") return make_unique<MultilevelQueueScheduler>(quantum, contextSwitch);
+    if (algorithm == "mlfq") return make_unique<MultilevelFeedbackQueueScheduler>(contextSwitch);
+    return nullptr;
+}
+
+bool algorithmUsesQuantum(const string& algorithm) {
+    return algorithm == "rr" || algorithm == "arr" || algorithm == "mlq";
+}
+
+bool algorithmUsesPredictor(const string& algorithm) {
+    return algorithm == "sjf" || algorithm == "pmlfq";
+}
+
+bool streamsWorkload(const BatchOptions& options) {
+    return options.generate || (!options.schedTracePath.empty() && options.schedTracePath != "-");
+}
+
+// Feeds a synthetic or imported workload to sink in arrival order, after
+// skipping the first skip processes
+static void streamWorkload(const BatchOptions& options, uint64_t skip, const TraceImporter::Sink& sink) {
+    if (!options.generate) {
+        uint64_t seen = 0;
+        importTrace(options.schedTracePath, options.schedTrace, [&](const Process& p) {
+            if (seen++ >= skip) {
+                sink(p);
+            }
+        });
+        return;
+    }
+    WorkloadGenerator generator(options.generator);
+    while (generator.generated() < skip && generator.hasNext()) {
+        generator.next();
+    }
+    while (generator.hasNext()) {
+        sink(generator.next());
+    }
+}
+
+// Materialized workloads run through schedule(); synthetic and imported ones
+// are streamed through the online API with aggregate-only retention, so
+// resident memory is proportional to the processes in flight. A resumed run
+// restores its snapshot after the same workload is re-added (or, for
+// streamed runs, before the processes already submitted are skipped).
+// Checkpointed runs keep aggregates only, so snapshots hold just the active
+// state.
+static void simulate(Scheduler& scheduler, const BatchOptions& options,
+                     const vector<Process>& workload, const string& resumePath) {
+    if (!streamsWorkload(options)) {
+        if (!options.checkpointPrefix.empty()) {
+            scheduler.setRetention(RETAIN_AGGREGATES);
+        }
+        for (const auto& p : workload) {
+            scheduler.addProcess(p);
+        }
+        if (!resumePath.empty()) {
+            scheduler.restoreCheckpoint(resumePath);
+        }
+        scheduler.schedule();
+        return;
+    }
+    
+    scheduler.setRetention(RETAIN_AGGREGATES);
+    uint64_t submitted = 0;
+    if (!resumePath.empty()) {
+        scheduler.restoreCheckpoint(resumePath);
+        submitted = scheduler.getProcessCount();
+    }
+    streamWorkload(options, submitted, [&](const Process& p) {
+        scheduler.advanceUntil(p.arrivalTime);
+        scheduler.submit(p);
+    });
+    while (scheduler.step()) {}
+    
+    if (options.trace != TRACE_NONE) {
+        scheduler.displayMetrics();
+    }
+}
+
+// Multi-CPU runs feed every arrival through the machine's placement, in
+// arrival order; a workload file is sorted first (shared with other runs)
+static void simulate(TopologySimulator& machine, const BatchOptions& options,
+                     const vector<Process>& workload) {
+    if (streamsWorkload(options)) {
+        streamWorkload(options, 0, [&](const Process& p) { machine.submit(p); });
+    } else {
+        auto sorted = sortedWorkload(workload);
+        for (const auto& p : *sorted) {
+            machine.submit(p);
+        }
+    }
+    machine.finish();
+    
+    if (options.trace != TRACE_NONE) {
+        machine.displayMetrics();
+    }
+}
+
+static string runPath(const string& prefix, const string& algorithm, int quantum,
+                      const string& extension) {
+    string path = prefix + "-" + algorithm;
+    if (quantum > 0) {
+        path += "-q" + to_string(quantum);
+    }
+    return path + extension;
+}
+
+// An oracle run is its own reference; a predicted one gets it from a twin run
+static void summarizePrediction(RunResult& result, const BurstPredictor* predictor, const PredictionError& error) {
+    result.predictor = predictor ? predictor->describe() : "";
+    result.predictionMae = error.meanAbsolute();
+    result.predictionBias = error.bias();
+    result.oracleWaiting = (predictor && predictor->isOracle()) ? result.avgWaiting : -1.0;
+}
+
+RunResult summarizeRun(const Scheduler& scheduler, int quantum, double wallTimeMs) {
+    RunResult result;
+    result.algorithm = scheduler.getName();
+    result.quantum = quantum;
+    result.numProcesses = scheduler.getProcessCount();
+    result.avgWaiting = scheduler.getAverageWaitingTime();
+    result.avgTurnaround = scheduler.getAverageTurnaroundTime();
+    result.avgResponse = scheduler.getAverageResponseTime();
+    result.p95Turnaround = scheduler.getAggregate().turnaround.getPercentile(0.95);
+    result.makespan = scheduler.getMakespan();
+    result.wallTimeMs = wallTimeMs;
+    result.cpus = 0;
+    result.migrations = 0;
+    result.cacheMisses = 0;
+    result.contextSwitches = scheduler.getContextSwitchCount();
+    result.switchTime = scheduler.getSwitchTime();
+    result.adaptiveQuantum = dynamic_cast<const AdaptiveRoundRobinScheduler*>(&scheduler) != nullptr;
+    summarizePrediction(result, scheduler.getBurstPredictor(), scheduler.getPredictionError());
+    result.phases = scheduler.getPhaseProfile();
+    result.cached = false;
+    return result;
+}
+
+RunResult summarizeRun(const TopologySimulator& machine, int quantum, double wallTimeMs) {
+    MetricsAggregate aggregate = machine.getAggregate();
+    RunResult result;
+    result.algorithm = machine.getName();
+    result.quantum = quantum;
+    result.numProcesses = machine.getProcessCount();
+    result.avgWaiting = aggregate.waiting.getMean();
+    result.avgTurnaround = aggregate.turnaround.getMean();
+    result.avgResponse = aggregate.response.getMean();
+    result.p95Turnaround = aggregate.turnaround.getPercentile(0.95);
+    result.makespan = machine.getMakespan();
+    result.wallTimeMs = wallTimeMs;
+    result.cpus = machine.getCpuCount();
+    result.migrations = machine.getCounters().migrations();
+    result.cacheMisses = machine.getCounters().cacheMisses();
+    result.contextSwitches = 0;
+    result.switchTime = 0;
+    for (int cpu = 0; cpu < machine.getCpuCount(); cpu++) {
+        result.contextSwitches += machine.getCpu(cpu).getContextSwitchCount();
+        result.switchTime += machine.getCpu(cpu).getSwitchTime();
+    }
+    result.adaptiveQuantum = dynamic_cast<const AdaptiveRoundRobinScheduler*>(&machine.getCpu(0)) != nullptr;
+    PredictionError error;
+    for (int cpu = 0; cpu < machine.getCpuCount(); cpu++) {
+        const PredictionError& local = machine.getCpu(cpu).getPredictionError();
+        error.count += local.count;
+        error.absoluteSum += local.absoluteSum;
+        error.signedSum += local.signedSum;
+    }
+    summarizePrediction(result, machine.getCpu(0).getBurstPredictor(), error);
+    result.phases = machine.getPhaseProfile();
+    result.cached = false;
+    return result;
+}
+
+// What the kernel delivered for the imported bursts, as a result row
+RunResult summarizeTrace(const TraceImportStats& trace, bool topology, double wallTimeMs) {
+    RunResult result;
+    result.algorithm = "Kernel (trace)";
+    result.quantum = 0;
+    result.numProcesses = trace.bursts;
+    result.avgWaiting = trace.kernel.waiting.getMean();
+    result.avgTurnaround = trace.kernel.turnaround.getMean();
+    result.avgResponse = trace.kernel.response.getMean();
+    result.p95Turnaround = trace.kernel.turnaround.getPercentile(0.95);
+    result.makespan = trace.makespan;
+    result.wallTimeMs = wallTimeMs;
+    result.cpus = topology ? trace.cpus : 0;
+    result.migrations = trace.migrations;
+    result.cacheMisses = 0;
+    result.contextSwitches = 0;
+    result.switchTime = 0;
+    result.adaptiveQuantum = false;
+    result.predictionMae = 0.0;
+    result.predictionBias = 0.0;
+    result.oracleWaiting = -1.0;
+    result.cached = false;
+    return result;
+}
+
+// Average waiting time of the same configuration scheduled with known bursts
+static double oracleWaiting(const string& algorithm, int quantum, const BatchOptions& options,
+                            const vector<Process>& workload) {
+    BatchOptions reference = options;
+    reference.trace = TRACE_NONE;
+    auto make = [&]() { return makeScheduler(algorithm, quantum, options.contextSwitch, "oracle"); };
+    if (options.useTopology) {
+        TopologySimulator machine(options.topology, make);
+        simulate(machine, reference, workload);
+        return machine.getAggregate().waiting.getMean();
+    }
+    unique_ptr<Scheduler> scheduler = make();
+    scheduler->setTraceLevel(TRACE_NONE);
+    simulate(*scheduler, reference, workload, "");
+    return scheduler->getAverageWaitingTime();
+}
+
+// With a result cache, each run is looked up before it is simulated and
+// stored after; traced runs always simulate so their output is printed
+vector<RunResult> runBatch(const BatchOptions& options, const vector<Process>& workload) {
+    vector<RunResult> results;
+    unique_ptr<ResultCache> cache;
+    string workloadId;
+    unique_ptr<Dashboard> dashboard;
+    if (options.dashboardFps > 0) {
+        dashboard = make_unique<Dashboard>(cerr, options.dashboardFps);
+    }
+    if (!options.cacheDir.empty()) {
+        cache = make_unique<ResultCache>(options.cacheDir);
+        workloadId = workloadKey(options, workload);
+    }
+    
+    for (const auto& algorithm : options.algorithms) {
+        vector<int> quanta = options.quanta;
+        if (!algorithmUsesQuantum(algorithm)) {
+            quanta = {0};
+        }
+        
+        for (int quantum : quanta) {
+            string key, spill;
+            if (!options.spillPrefix.empty()) {
+                spill = runPath(options.spillPrefix, algorithm, quantum, ".csv");
+            }
+            if (cache) {
+                key = runKey(workloadId, algorithm, quantum, options);
+                auto start = chrono::steady_clock::now();
+                RunResult hit;
+                if (options.trace == TRACE_NONE && cache->load(key, hit, spill)) {
+                    hit.wallTimeMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+                    results.push_back(hit);
+                    continue;
+                }
+            }
+            
+            if (options.useTopology) {
+                TopologySimulator machine(options.topology, [&]() {
+                    return makeScheduler(algorithm, quantum, options.contextSwitch, options.predictor);
+                });
+                auto start = chrono::steady_clock::now();
+                simulate(machine, options, workload);
+                auto end = chrono::steady_clock::now();
+                
+                double wallTimeMs = chrono::duration<double, milli>(end - start).count();
+                results.push_back(summarizeRun(machine, quantum, wallTimeMs));
+                if (results.back().oracleWaiting < 0 && !results.back().predictor.empty()) {
+                    results.back().oracleWaiting = oracleWaiting(algorithm, quantum, options, workload);
+                }
+                if (cache) {
+                    cache->store(key, results.back());
+                }
+                continue;
+            }
+            
+            unique_ptr<Scheduler> scheduler = makeScheduler(algorithm, quantum, options.contextSwitch,
+                                                            options.predictor);
+            scheduler->setTraceLevel(options.trace);
+            
+            string checkpoint, resumePath;
+            if (!options.checkpointPrefix.empty()) {
+                checkpoint = runPath(options.checkpointPrefix, algorithm, quantum, ".ckpt");
+                scheduler->setCheckpoint(checkpoint, options.checkpointInterval);
+                if (filesystem::exists(checkpoint)) {
+                    resumePath = checkpoint;
+                }
+            }
+            // A resumed run reopens its own spill file from the snapshot
+            if (!spill.empty() && resumePath.empty()) {
+                scheduler->setSpillFile(spill);
+            }
+            
+            ResultColumns columns;
+            if (!options.breakdownPath.empty()) {
+                scheduler->setResultColumns(&columns);
+            }
+            if (dashboard) {
+                scheduler->setSnapshotChannel(&dashboard->getChannel());
+                dashboard->start(scheduler->getName());
+            }
+            
+            auto start = chrono::steady_clock::now();
+            simulate(*scheduler, options, workload, resumePath);
+            if (!checkpoint.empty()) {
+                scheduler->saveCheckpoint(checkpoint);
+            }
+            auto end = chrono::steady_clock::now();
+            if (dashboard) {
+                scheduler->publishSnapshot();
+                dashboard->stop();
+            }
+            
+            double wallTimeMs = chrono::duration<double, milli>(end - start).count();
+            results.push_back(summarizeRun(*scheduler, quantum, wallTimeMs));
+            if (!options.breakdownPath.empty()) {
+                results.back().breakdown = make_shared<MetricsBreakdown>(analyzeResults(columns));
+            }
+            if (results.back().oracleWaiting < 0 && !results.back().predictor.empty()) {
+                results.back().oracleWaiting = oracleWaiting(algorithm, quantum, options, workload);
+            }
+            if (!cache) continue;
+            if (!streamsWorkload(options) && options.checkpointPrefix.empty()) {
+                cache->store(key, results.back(), scheduler->getRetainedProcesses());
+            } else if (!streamsWorkload(options)) {
+                cache->store(key, results.back());
+            } else {
+                scheduler.reset();  // closes the spill file
+                cache->store(key, results.back(), spill);
+            }
+        }
+    }
+    
+    return results;
+}
+
+// Share of the machine's time spent switching
+static double switchOverhead(const RunResult& r) {
+    long long capacity = (long long)r.makespan * max(r.cpus, 1);
+    return capacity > 0 ? 100.0 * r.switchTime / capacity : 0.0;
+}
+
+// Waiting time against scheduling with known bursts, in percent
+static string versusOracle(const RunResult& r) {
+    if (r.oracleWaiting < 0) return "n/a";
+    if (r.oracleWaiting == 0.0) return r.avgWaiting == 0.0 ? "+0.0%" : "n/a";
+    ostringstream text;
+    text << showpos << fixed << setprecision(1) << (r.avgWaiting - r.oracleWaiting) * 100.0 / r.oracleWaiting << "%";
+    return text.str();
+}
+
+// Topology columns only appear when some run simulated a machine, switch
+// columns when some run adapted its quantum (for comparison with fixed RR),
+// prediction columns when some run planned with predicted bursts
+void writeResults(ostream& out, const vector<RunResult>& results, OutputFormat format) {
+    out << fixed << setprecision(2);
+    bool topology = any_of(results.begin(), results.end(), [](const RunResult& r) { return r.cpus > 0; });
+    bool switches = any_of(results.begin(), results.end(), [](const RunResult& r) { return r.adaptiveQuantum; });
+    bool predicted = any_of(results.begin(), results.end(), [](const RunResult& r) { return !r.predictor.empty(); });
+    
+    if (format == FORMAT_CSV) {
+        out << "algorithm,quantum,processes,avg_waiting,avg_turnaround,avg_response,p95_turnaround,makespan,wall_ms"
+            << (topology ? ",cpus,migrations,cache_misses" : "")
+            << (switches ? ",context_switches,switch_time,switch_overhead" : "")
+            << (predicted ? ",predictor,prediction_mae,prediction_bias,oracle_waiting" : "") << "\n";
+        for (const auto& r : results) {
+            out << '"' << r.algorithm << "\"," << r.quantum << ',' << r.numProcesses << ','
+                << r.avgWaiting << ',' << r.avgTurnaround << ',' << r.avgResponse << ','
+                << r.p95Turnaround << ','
+                << r.makespan << ',' << setprecision(3) << r.wallTimeMs << setprecision(2);
+            if (topology) {
+                out << ',' << r.cpus << ',' << r.migrations << ',' << r.cacheMisses;
+            }
+            if (switches) {
+                out << ',' << r.contextSwitches << ',' << r.switchTime << ',' << switchOverhead(r);
+            }
+            if (predicted) {
+                out << ",\"" << r.predictor << "\"," << r.predictionMae << ',' << r.predictionBias << ',';
+                if (r.oracleWaiting >= 0) out << r.oracleWaiting;
+            }
+            out << '\n';
+        }
+    } else if (format == FORMAT_JSON) {
+        out << "[\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const auto& r = results[i];
+            out << "  {\"algorithm\": \"" << r.algorithm << "\", \"quantum\": " << r.quantum
+                << ", \"processes\": " << r.numProcesses
+                << ", \"avg_waiting\": " << r.avgWaiting
+                << ", \"avg_turnaround\": " << r.avgTurnaround
+                << ", \"avg_response\": " << r.avgResponse
+                << ", \"p95_turnaround\": " << r.p95Turnaround
+                << ", \"makespan\": " << r.makespan
+                << ", \"wall_ms\": " << setprecision(3) << r.wallTimeMs << setprecision(2);
+            if (topology) {
+                out << ", \"cpus\": " << r.cpus << ", \"migrations\": " << r.migrations
+                    << ", \"cache_misses\": " << r.cacheMisses;
+            }
+            if (switches) {
+                out << ", \"context_switches\": " << r.contextSwitches << ", \"switch_time\": " << r.switchTime
+                    << ", \"switch_overhead\": " << switchOverhead(r);
+            }
+            if (predicted) {
+                out << ", \"predictor\": \"" << r.predictor << "\", \"prediction_mae\": " << r.predictionMae
+                    << ", \"prediction_bias\": " << r.predictionBias << ", \"oracle_waiting\": ";
+                if (r.oracleWaiting >= 0) out << r.oracleWaiting;
+                else out << "null";
+            }
+            out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "]\n";
+    } else {
+        out << "\n========== Batch Summary ==========\n";
+        out << left << setw(28) << "Algorithm"
+            << right << setw(11) << "Processes"
+            << setw(12) << "Avg Wait"
+            << setw(12) << "Avg Turn"
+            << setw(12) << "Avg Resp"
+            << setw(12) << "p95 Turn"
+            << setw(11) << "Makespan"
+            << setw(12) << "Wall(ms)";
+        if (topology) {
+            out << setw(6) << "CPUs" << setw(12) << "Migrations" << setw(12) << "Misses";
+        }
+        if (switches) {
+            out << setw(12) << "Switches" << setw(10) << "Switch%";
+        }
+        if (predicted) {
+            out << setw(10) << "Pred MAE" << setw(11) << "vs Oracle";
+        }
+        size_t width = 110 + (topology ? 30 : 0) + (switches ? 22 : 0) + (predicted ? 21 : 0);
+        out << "\n" << string(width, '-') << "\n";
+        for (const auto& r : results) {
+            out << left << setw(28) << r.algorithm
+                << right << setw(11) << r.numProcesses
+                << setw(12) << r.avgWaiting
+                << setw(12) << r.avgTurnaround
+                << setw(12) << r.avgResponse
+                << setw(12) << r.p95Turnaround
+                << setw(11) << r.makespan
+                << setw(12) << setprecision(3) << r.wallTimeMs << setprecision(2);
+            if (topology) {
+                out << setw(6) << r.cpus << setw(12) << r.migrations << setw(12) << r.cacheMisses;
+            }
+            if (switches) {
+                out << setw(12) << r.contextSwitches << setw(9) << switchOverhead(r) << "%";
+            }
+            if (predicted) {
+                if (r.predictor.empty()) {
+                    out << setw(10) << "-" << setw(11) << "-";
+                } else {
+                    out << setw(10) << r.predictionMae << setw(11) << versusOracle(r);
+                }
+            }
+            out << "\n";
+        }
+        out << string(width, '=') << "\n";
+    }
+}
+
+// Simulated runs only; the kernel trace row has nothing to profile
+void writePhaseProfiles(ostream& out, const vector<RunResult>& results) {
+    out << "[\n";
+    bool first = true;
+    for (const auto& r : results) {
+        if (r.phases.ticks == 0) continue;
+        out << (first ? "" : ",\n") << "  {\"algorithm\": \"" << r.algorithm
+            << "\", \"quantum\": " << r.quantum << ", \"profile\": ";
+        r.phases.writeJson(out);
+        out << "}";
+        first = false;
+    }
+    out << (first ? "" : "\n") << "]\n";
+}
+
+void writeBreakdowns(ostream& out, const vector<RunResult>& results) {
+    for (const auto& r : results) {
+        if (r.breakdown) {
+            r.breakdown->write(out, r.algorithm);
+        }
+    }
+}
+
+static void emitWorkload(const BatchOptions& options, const string& path) {
+    ofstream file;
+    if (path != "-") {
+        file.open(path);
+        if (!file) {
+            throw runtime_error("cannot write '" + path + "'");
+        }
+    }
+    ostream& out = (path == "-") ? cout : file;
+    
+    writeWorkloadHeader(out);
+    if (!options.schedTracePath.empty()) {
+        importTrace(options.schedTracePath, options.schedTrace,
+                    [&](const Process& p) { writeWorkloadLine(out, p); });
+        return;
+    }
+    WorkloadGenerator generator(options.generator);
+    while (generator.hasNext()) {
+        writeWorkloadLine(out, generator.next());
+    }
+}
+
+int batchMain(int argc, char** argv) {
+    BatchOptions options;
+    string error;
+    
+    if (!parseBatchArgs(argc, argv, options, error)) {
+        if (error == "help") {
+            printBatchUsage(cout, argv[0]);
+            return 0;
+        }
+        cerr << argv[0] << ": " << error << "\n";
+        printBatchUsage(cerr, argv[0]);
+        return 2;
+    }
+    
+    try {
+        if (!options.emitPath.empty()) {
+            emitWorkload(options, options.emitPath);
+            return 0;
+        }
+        
+        vector<Process> workload;
+        TraceImportStats trace;
+        double importMs = 0.0;
+        if (!options.schedTracePath.empty()) {
+            // Runs re-import a trace file themselves; this pass only gathers
+            // its statistics unless the bursts have to be held
+            bool hold = !streamsWorkload(options) || options.advisePrefix > 0 || options.branchTime >= 0;
+            auto start = chrono::steady_clock::now();
+            trace = importTrace(options.schedTracePath, options.schedTrace, [&](const Process& p) {
+                if (hold) {
+                    workload.push_back(p);
+                }
+            });
+            importMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        } else if (!options.generate) {
+            workload = loadWorkload(options.workloadPath);
+        }
+        bool empty = options.generate ? options.generator.count == 0
+                                      : options.schedTracePath.empty() ? workload.empty() : trace.bursts == 0;
+        if (empty) {
+            throw runtime_error("workload contains no processes");
+        }
+        
+        if (options.advisePrefix > 0) {
+            AdvisorReport report = adviseWorkload(options, workload);
+            ofstream file;
+            if (!options.outputPath.empty()) {
+                file.open(options.outputPath);
+                if (!file) {
+                    throw runtime_error("cannot write '" + options.outputPath + "'");
+                }
+            }
+            writeAdvice(options.outputPath.empty() ? cout : file, report, options.format);
+            return 0;
+        }
+        
+        bool whatIf = options.branchTime >= 0;
+        vector<RunResult> results = whatIf ? runWhatIf(options, workload) : runBatch(options, workload);
+        if (!options.schedTracePath.empty()) {
+            results.push_back(summarizeTrace(trace, options.useTopology, importMs));
+        }
+        
+        ofstream file;
+        if (!options.outputPath.empty()) {
+            file.open(options.outputPath);
+            if (!file) {
+                throw runtime_error("cannot write '" + options.outputPath + "'");
+            }
+        }
+        ostream& out = options.outputPath.empty() ? cout : file;
+        writeResults(out, results, options.format);
+        if (whatIf && options.format == FORMAT_TABLE) {
+            writeComparison(out, results);
+        }
+        if (!options.schedTracePath.empty() && options.format == FORMAT_TABLE) {
+            out << "Trace: " << trace.events << " events on " << trace.cpus << " CPU(s), "
+                << trace.bursts << " bursts (" << trace.truncatedBursts << " cut off at the end, "
+                << trace.splitBursts << " split), "
+                << trace.ioWaits << " I/O waits totalling " << trace.ioWaitTime << "\n";
+        }
+        if (!options.cacheDir.empty() && options.format == FORMAT_TABLE) {
+            // The kernel row of a trace import is not a simulated run
+            size_t runs = results.size() - !options.schedTracePath.empty();
+            size_t hits = count_if(results.begin(), results.end(), [](const RunResult& r) { return r.cached; });
+            out << "Result cache: " << hits << " of " << runs << " run(s) reused from "
+                << options.cacheDir << "\n";
+        }
+        
+        if (options.phaseProfilePath == "-") {
+            writePhaseProfiles(cout, results);
+        } else if (!options.phaseProfilePath.empty()) {
+            ofstream profile(options.phaseProfilePath);
+            if (!profile) {
+                throw runtime_error("cannot write '" + options.phaseProfilePath + "'");
+            }
+            writePhaseProfiles(profile, results);
+        }
+        if (options.breakdownPath == "-") {
+            writeBreakdowns(cout, results);
+        } else if (!options.breakdownPath.empty()) {
+            ofstream breakdown(options.breakdownPath);
+            if (!breakdown) {
+                throw runtime_error("cannot write '" + options.breakdownPath + "'");
+            }
+            writeBreakdowns(breakdown, results);
+        }
+    } catch (const exception& e) {
+        cerr << argv[0] << ": " << e.what() << "\n";
+        return 1;
+    }
+    
+    return 0;
+}
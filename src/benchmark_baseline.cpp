@@ -0,0 +1,222 @@
+// src/benchmark_baseline.cpp
+// Benchmark baselines: saving, loading and significance-tested comparison
+
+#include "benchmark_baseline.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <stdexcept>
+
+using namespace std;
+
+// ============== SimulatedOutcome Implementation ==============
+string SimulatedOutcome::differences(const SimulatedOutcome& other) const {
+    string fields;
+    auto check = [&fields](bool same, const char* name) {
+        if (!same) {
+            fields += (fields.empty() ? "" : ",") + string(name);
+        }
+    };
+    check(completed == other.completed, "completed");
+    check(makespan == other.makespan, "makespan");
+    check(contextSwitches == other.contextSwitches, "switches");
+    check(switchTime == other.switchTime, "switch_time");
+    check(waiting == other.waiting, "waiting");
+    check(turnaround == other.turnaround, "turnaround");
+    check(response == other.response, "response");
+    return fields;
+}
+
+SimulatedOutcome outcomeOf(const Scheduler& scheduler) {
+    const MetricsAggregate& aggregate = scheduler.getAggregate();
+    return SimulatedOutcome{scheduler.getCompletedCount(), scheduler.getMakespan(),
+                            scheduler.getContextSwitchCount(), scheduler.getSwitchTime(),
+                            aggregate.waiting.getSum(), aggregate.turnaround.getSum(),
+                            aggregate.response.getSum()};
+}
+
+// ============== BenchmarkCase Implementation ==============
+static double median(vector<double> values) {
+    if (values.empty()) return 0.0;
+    size_t middle = values.size() / 2;
+    nth_element(values.begin(), values.begin() + middle, values.end());
+    double upper = values[middle];
+    if (values.size() % 2) return upper;
+    double lower = *max_element(values.begin(), values.begin() + middle);
+    return (lower + upper) / 2;
+}
+
+double BenchmarkCase::medianMs() const {
+    return median(samplesMs);
+}
+
+// ============== Baseline Files ==============
+// One line per case: identity, outcome, then the samples
+void saveBaseline(ostream& out, const vector<BenchmarkCase>& cases) {
+    out << "benchmark-baseline " << BENCHMARK_BASELINE_VERSION << "\n";
+    out << setprecision(17);
+    for (const auto& c : cases) {
+        const SimulatedOutcome& o = c.outcome;
+        out << c.algorithm << ' ' << c.processes << ' ' << o.completed << ' ' << o.makespan << ' '
+            << o.contextSwitches << ' ' << o.switchTime << ' ' << o.waiting << ' ' << o.turnaround << ' '
+            << o.response << ' ' << c.samplesMs.size();
+        for (double sample : c.samplesMs) {
+            out << ' ' << sample;
+        }
+        out << "\n";
+    }
+    if (!out) {
+        throw runtime_error("cannot write the benchmark baseline");
+    }
+}
+
+vector<BenchmarkCase> loadBaseline(istream& in) {
+    string tag;
+    uint32_t version = 0;
+    in >> tag >> version;
+    if (!in || tag != "benchmark-baseline") {
+        throw runtime_error("not a benchmark baseline");
+    }
+    if (version != BENCHMARK_BASELINE_VERSION) {
+        throw runtime_error("benchmark baseline version " + to_string(version) + " (expected " +
+                            to_string(BENCHMARK_BASELINE_VERSION) + ")");
+    }
+    
+    vector<BenchmarkCase> cases;
+    BenchmarkCase c;
+    size_t samples = 0;
+    while (in >> c.algorithm) {
+        SimulatedOutcome& o = c.outcome;
+        in >> c.processes >> o.completed >> o.makespan >> o.contextSwitches >> o.switchTime >> o.waiting
+           >> o.turnaround >> o.response >> samples;
+        c.samplesMs.assign(samples, 0.0);
+        for (double& sample : c.samplesMs) {
+            in >> sample;
+        }
+        if (!in) {
+            throw runtime_error("benchmark baseline entry " + to_string(cases.size() + 1) + " is malformed");
+        }
+        cases.push_back(c);
+    }
+    return cases;
+}
+
+// ============== Comparison ==============
+// Ranks the pooled samples (ties share their average rank), then the
+// normal approximation of U; exact enough from about eight samples a side
+double mannWhitneyPValue(const vector<double>& a, const vector<double>& b) {
+    size_t n1 = a.size(), n2 = b.size(), n = n1 + n2;
+    if (n1 == 0 || n2 == 0) return 1.0;
+    
+    vector<pair<double, int>> pooled;
+    for (double value : a) pooled.push_back({value, 0});
+    for (double value : b) pooled.push_back({value, 1});
+    sort(pooled.begin(), pooled.end());
+    
+    double rankSumA = 0.0;
+    double tieTerm = 0.0;
+    for (size_t i = 0; i < n;) {
+        size_t j = i;
+        while (j < n && pooled[j].first == pooled[i].first) j++;
+        double rank = (i + 1 + j) / 2.0;
+        for (size_t k = i; k < j; k++) {
+            if (pooled[k].second == 0) rankSumA += rank;
+        }
+        double tied = (double)(j - i);
+        tieTerm += tied * tied * tied - tied;
+        i = j;
+    }
+    
+    double u = rankSumA - n1 * (n1 + 1) / 2.0;
+    double mean = n1 * n2 / 2.0;
+    double variance = n1 * n2 / 12.0 * ((n + 1) - tieTerm / ((double)n * (n - 1)));
+    if (variance <= 0.0) return 1.0;
+    double z = max(fabs(u - mean) - 0.5, 0.0) / sqrt(variance);
+    return erfc(z / sqrt(2.0));
+}
+
+bool CaseComparison::failed() const {
+    return timing == TIMING_SLOWER || !drift.empty();
+}
+
+static const BenchmarkCase* findCase(const vector<BenchmarkCase>& cases, const string& algorithm,
+                                     uint64_t processes) {
+    for (const auto& c : cases) {
+        if (c.algorithm == algorithm && c.processes == processes) return &c;
+    }
+    return nullptr;
+}
+
+BaselineComparison compareToBaseline(const vector<BenchmarkCase>& baseline, const vector<BenchmarkCase>& current,
+                                     double alpha, double minChange) {
+    BaselineComparison comparison{1.0, {}};
+    const BenchmarkCase* calibrationBefore = findCase(baseline, CALIBRATION_CASE, 0);
+    const BenchmarkCase* calibrationNow = findCase(current, CALIBRATION_CASE, 0);
+    if (calibrationBefore && calibrationNow && calibrationBefore->medianMs() > 0.0) {
+        comparison.machineFactor = calibrationNow->medianMs() / calibrationBefore->medianMs();
+    }
+    
+    for (const auto& now : current) {
+        if (&now == calibrationNow) continue;
+        
+        vector<double> scaled = now.samplesMs;
+        for (double& sample : scaled) {
+            sample /= comparison.machineFactor;
+        }
+        CaseComparison row{now.algorithm, now.processes, 0.0, median(scaled), 0.0, 1.0, TIMING_NEW, ""};
+        const BenchmarkCase* before = findCase(baseline, now.algorithm, now.processes);
+        if (before != nullptr) {
+            row.baselineMs = before->medianMs();
+            row.change = row.baselineMs > 0.0 ? row.currentMs / row.baselineMs - 1.0 : 0.0;
+            row.pValue = mannWhitneyPValue(before->samplesMs, scaled);
+            row.timing = TIMING_UNCHANGED;
+            if (row.pValue < alpha && row.change > minChange) row.timing = TIMING_SLOWER;
+            if (row.pValue < alpha && row.change < -minChange) row.timing = TIMING_FASTER;
+            row.drift = now.outcome.differences(before->outcome);
+        }
+        comparison.cases.push_back(row);
+    }
+    return comparison;
+}
+
+size_t writeComparison(ostream& out, const BaselineComparison& comparison) {
+    const vector<CaseComparison>& comparisons = comparison.cases;
+    static const char* VERDICTS[] = {"same", "faster", "SLOWER", "new"};
+    
+    out << "\n========== Baseline Comparison (median ms) ==========\n";
+    out << left << setw(10) << "Policy"
+        << right << setw(11) << "Processes"
+        << setw(12) << "Baseline"
+        << setw(12) << "Current"
+        << setw(10) << "Change"
+        << setw(11) << "p-value"
+        << setw(9) << "Timing"
+        << setw(12) << "Mproc/sec"
+        << "  Outcome\n";
+    out << string(97, '-') << "\n";
+    
+    size_t failures = 0;
+    for (const auto& row : comparisons) {
+        double throughput = row.currentMs > 0.0 ? row.processes / row.currentMs / 1000.0 : 0.0;
+        out << left << setw(10) << row.algorithm << right << setw(11) << row.processes << fixed;
+        if (row.timing == TIMING_NEW) {
+            out << setw(12) << "-" << setw(12) << setprecision(3) << row.currentMs << setw(10) << "-"
+                << setw(11) << "-" << setw(9) << VERDICTS[row.timing] << setw(12) << setprecision(2)
+                << throughput << "  -\n";
+            continue;
+        }
+        out << setw(12) << setprecision(3) << row.baselineMs << setw(12) << row.currentMs
+            << setw(9) << setprecision(1) << showpos << row.change * 100 << noshowpos << "%"
+            << setw(11) << scientific << setprecision(1) << row.pValue << fixed
+            << setw(9) << VERDICTS[row.timing] << setw(12) << setprecision(2) << throughput << "  "
+            << (row.drift.empty() ? "exact" : "DRIFT: " + row.drift) << "\n";
+        if (row.failed()) failures++;
+    }
+    out << string(97, '=') << "\n";
+    if (comparison.machineFactor != 1.0) {
+        out << "Machine speed: calibration took " << fixed << setprecision(2) << comparison.machineFactor
+            << "x its baseline time; current timings are scaled by that\n";
+    }
+    out << failures << " of " << comparisons.size() << " case(s) regressed or drifted\n";
+    return failures;
+}
@@ -0,0 +1,155 @@
+// src/burst_predictor.cpp
+// Burst-length predictors for SJF approximation and MLFQ placement
+
+#include "burst_predictor.h"
+#include "scheduler.h"
+#include "checkpoint.h"
+#include <sstream>
+
+using namespace std;
+
+// ============== BurstPredictor Implementation ==============
+bool BurstPredictor::isOracle() const {
+    return false;
+}
+
+int BurstPredictor::classOf(const Process& p) {
+    return p.priority < 0 ? 0 : min(p.priority, CLASSES - 1);
+}
+
+// ============== OraclePredictor Implementation ==============
+double OraclePredictor::predict(const Process& p) const {
+    return p.burstTime;
+}
+
+void OraclePredictor::observe(const Process&) {}
+
+string OraclePredictor::describe() const {
+    return "oracle";
+}
+
+bool OraclePredictor::isOracle() const {
+    return true;
+}
+
+void OraclePredictor::save(CheckpointWriter&) const {}
+
+void OraclePredictor::load(CheckpointReader&) {}
+
+// ============== ExponentialAveragePredictor Implementation ==============
+ExponentialAveragePredictor::ExponentialAveragePredictor(double weight, double initialGuess)
+    : alpha(weight) {
+    for (double& estimate : estimates) {
+        estimate = initialGuess;
+    }
+}
+
+double ExponentialAveragePredictor::predict(const Process& p) const {
+    return estimates[classOf(p)];
+}
+
+void ExponentialAveragePredictor::observe(const Process& p) {
+    double& estimate = estimates[classOf(p)];
+    estimate = alpha * p.burstTime + (1.0 - alpha) * estimate;
+}
+
+string ExponentialAveragePredictor::describe() const {
+    ostringstream name;
+    name << "exp " << alpha;
+    return name.str();
+}
+
+void ExponentialAveragePredictor::save(CheckpointWriter& out) const {
+    for (double estimate : estimates) {
+        out.writeDouble(estimate);
+    }
+}
+
+void ExponentialAveragePredictor::load(CheckpointReader& in) {
+    for (double& estimate : estimates) {
+        estimate = in.readDouble();
+    }
+}
+
+// ============== ClassQuantilePredictor Implementation ==============
+ClassQuantilePredictor::ClassQuantilePredictor(double q, double guess)
+    : quantile(q), initialGuess(guess) {
+    for (auto& estimate : estimates) {
+        estimate = StreamingQuantile(q);
+    }
+}
+
+double ClassQuantilePredictor::predict(const Process& p) const {
+    const StreamingQuantile& estimate = estimates[classOf(p)];
+    return estimate.getCount() > 0 ? estimate.get() : initialGuess;
+}
+
+void ClassQuantilePredictor::observe(const Process& p) {
+    estimates[classOf(p)].add(p.burstTime);
+}
+
+string ClassQuantilePredictor::describe() const {
+    ostringstream name;
+    name << "p" << (int)(quantile * 100 + 0.5);
+    return name.str();
+}
+
+void ClassQuantilePredictor::save(CheckpointWriter& out) const {
+    for (const auto& estimate : estimates) {
+        estimate.save(out);
+    }
+}
+
+void ClassQuantilePredictor::load(CheckpointReader& in) {
+    for (auto& estimate : estimates) {
+        estimate.load(in);
+    }
+}
+
+// The parameter must lie in (0, 1]
+static bool parseFraction(const string& spec, size_t colon, double fallback, double& value) {
+    value = fallback;
+    if (colon == string::npos) return true;
+    try {
+        size_t used = 0;
+        string text = spec.substr(colon + 1);
+        value = stod(text, &used);
+        return used == text.size() && value > 0.0 && value <= 1.0;
+    } catch (const exception&) {
+        return false;
+    }
+}
+
+unique_ptr<BurstPredictor> makeBurstPredictor(const string& spec) {
+    size_t colon = spec.find(':');
+    string kind = spec.substr(0, colon);
+    double value;
+    if (kind == "oracle" && colon == string::npos) {
+        return make_unique<OraclePredictor>();
+    }
+    if (kind == "exp" && parseFraction(spec, colon, 0.5, value)) {
+        return make_unique<ExponentialAveragePredictor>(value);
+    }
+    if (kind == "quantile" && parseFraction(spec, colon, 0.5, value)) {
+        return make_unique<ClassQuantilePredictor>(value);
+    }
+    return nullptr;
+}
+
+// ============== PredictionError Implementation ==============
+PredictionError::PredictionError() : count(0), absoluteSum(0.0), signedSum(0.0) {}
+
+void PredictionError::add(double predicted, long long actual) {
+    double error = predicted - actual;
+    count++;
+    absoluteSum += error < 0 ? -error : error;
+    signedSum += error;
+}
+
+double PredictionError::meanAbsolute() const {
+    return count > 0 ? absoluteSum / count : 0.0;
+}
+
+double PredictionError::bias() const {
+    return count > 0 ? signedSum / count : 0.0;
+}
@@ -0,0 +1,192 @@
+// src/checkpoint.cpp
+// Binary encoding helpers for simulation checkpoints
+
+#include "checkpoint.h"
+#include "scheduler.h"
+#include <stdexcept>
+
+using namespace std;
+
+static const uint32_t NO_SLOT = UINT32_MAX;
+static const uint32_t MAX_STRING = 1 << 16;
+
+// ============== CheckpointWriter Implementation ==============
+CheckpointWriter::CheckpointWriter(ostream& stream) : out(stream) {}
+
+void CheckpointWriter::writeU32(uint32_t value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void CheckpointWriter::writeU64(uint64_t value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void CheckpointWriter::writeI32(int32_t value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void CheckpointWriter::writeI64(int64_t value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void CheckpointWriter::writeDouble(double value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void CheckpointWriter::writeString(const string& value) {
+    writeU32((uint32_t)value.size());
+    out.write(value.data(), value.size());
+}
+
+void CheckpointWriter::writeProcess(const Process& p) {
+    int32_t fields[] = {p.pid, p.arrivalTime, p.burstTime, p.remainingTime, p.priority,
+                        p.waitingTime, p.turnaroundTime, p.responseTime, p.completionTime,
+                        p.startTime, (int32_t)p.state, p.firstExecution ? 1 : 0};
+    out.write(reinterpret_cast<const char*>(fields), sizeof(fields));
+}
+
+void CheckpointWriter::bindSlot(const Process* p) {
+    uint32_t index = (uint32_t)slotIndex.size();
+    slotIndex[p] = index;
+}
+
+void CheckpointWriter::writeSlot(const Process* p) {
+    if (p == nullptr) {
+        writeU32(NO_SLOT);
+        return;
+    }
+    auto it = slotIndex.find(p);
+    if (it == slotIndex.end()) {
+        throw logic_error("checkpoint refers to a process slot that was not saved");
+    }
+    writeU32(it->second);
+}
+
+void CheckpointWriter::writeSlots(const deque<Process*>& queue) {
+    writeU64(queue.size());
+    for (const Process* p : queue) {
+        writeSlot(p);
+    }
+}
+
+void CheckpointWriter::writeSlots(const vector<Process*>& queue) {
+    writeU64(queue.size());
+    for (const Process* p : queue) {
+        writeSlot(p);
+    }
+}
+
+// ============== CheckpointReader Implementation ==============
+CheckpointReader::CheckpointReader(istream& stream) : in(stream) {}
+
+void CheckpointReader::readBytes(void* data, size_t size) {
+    in.read(static_cast<char*>(data), size);
+    if ((size_t)in.gcount() != size) {
+        throw runtime_error("checkpoint is truncated");
+    }
+}
+
+uint32_t CheckpointReader::readU32() {
+    uint32_t value;
+    readBytes(&value, sizeof(value));
+    return value;
+}
+
+uint64_t CheckpointReader::readU64() {
+    uint64_t value;
+    readBytes(&value, sizeof(value));
+    return value;
+}
+
+int32_t CheckpointReader::readI32() {
+    int32_t value;
+    readBytes(&value, sizeof(value));
+    return value;
+}
+
+int64_t CheckpointReader::readI64() {
+    int64_t value;
+    readBytes(&value, sizeof(value));
+    return value;
+}
+
+double CheckpointReader::readDouble() {
+    double value;
+    readBytes(&value, sizeof(value));
+    return value;
+}
+
+string CheckpointReader::readString() {
+    uint32_t size = readU32();
+    if (size > MAX_STRING) {
+        throw runtime_error("checkpoint is corrupt");
+    }
+    string value(size, '\0');
+    readBytes(value.data(), value.size());
+    return value;
+}
+
+void CheckpointReader::readProcess(Process& p) {
+    int32_t fields[12];
+    readBytes(fields, sizeof(fields));
+    if (fields[10] < NEW || fields[10] > TERMINATED) {
+        throw runtime_error("checkpoint holds an invalid process state");
+    }
+    p.pid = fields[0];
+    p.arrivalTime = fields[1];
+    p.burstTime = fields[2];
+    p.remainingTime = fields[3];
+    p.priority = fields[4];
+    p.waitingTime = fields[5];
+    p.turnaroundTime = fields[6];
+    p.responseTime = fields[7];
+    p.completionTime = fields[8];
+    p.startTime = fields[9];
+    p.state = (ProcessState)fields[10];
+    p.firstExecution = fields[11] != 0;
+}
+
+void CheckpointReader::bindSlot(Process* p) {
+    slots.push_back(p);
+}
+
+Process* CheckpointReader::readSlot() {
+    uint32_t index = readU32();
+    if (index == NO_SLOT) {
+        return nullptr;
+    }
+    if (index >= slots.size()) {
+        throw runtime_error("checkpoint refers to an unknown process slot");
+    }
+    return slots[index];
+}
+
+void CheckpointReader::readSlots(deque<Process*>& queue) {
+    queue.clear();
+    uint64_t count = readU64();
+    if (count > slots.size()) {
+        throw runtime_error("checkpoint queue is larger than the saved slots");
+    }
+    for (uint64_t i = 0; i < count; i++) {
+        Process* p = readSlot();
+        if (p == nullptr) {
+            throw runtime_error("checkpoint queue holds an empty slot");
+        }
+        queue.push_back(p);
+    }
+}
+
+void CheckpointReader::readSlots(vector<Process*>& queue) {
+    queue.clear();
+    uint64_t count = readU64();
+    if (count > slots.size()) {
+        throw runtime_error("checkpoint queue is larger than the saved slots");
+    }
+    for (uint64_t i = 0; i < count; i++) {
+        Process* p = readSlot();
+        if (p == nullptr) {
+            throw runtime_error("checkpoint queue holds an empty slot");
+        }
+        queue.push_back(p);
+    }
+}
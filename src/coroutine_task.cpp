@@ -0,0 +1,73 @@
+// src/coroutine_task.cpp
+// C++20 coroutine tasks preempted at cooperative yield points
+
+#include "coroutine_task.h"
+#include <exception>
+#include <memory>
+
+using namespace std;
+
+// Context of the slice the current worker thread is running, if any
+static thread_local TaskContext* currentContext = nullptr;
+
+// ============== PreemptibleTask Implementation ==============
+PreemptibleTask PreemptibleTask::promise_type::get_return_object() {
+    return PreemptibleTask(Handle::from_promise(*this));
+}
+
+void PreemptibleTask::promise_type::unhandled_exception() {
+    // Task bodies run on worker threads with nobody to report to
+    terminate();
+}
+
+PreemptibleTask::PreemptibleTask(Handle h) : handle(h) {}
+
+PreemptibleTask::PreemptibleTask(PreemptibleTask&& other) noexcept
+    : handle(other.handle) {
+    other.handle = nullptr;
+}
+
+PreemptibleTask& PreemptibleTask::operator=(PreemptibleTask&& other) noexcept {
+    if (this != &other) {
+        if (handle) handle.destroy();
+        handle = other.handle;
+        other.handle = nullptr;
+    }
+    return *this;
+}
+
+PreemptibleTask::~PreemptibleTask() {
+    if (handle) handle.destroy();
+}
+
+bool PreemptibleTask::resume() {
+    if (!handle.done()) {
+        handle.resume();
+    }
+    return handle.done();
+}
+
+bool PreemptibleTask::done() const {
+    return handle.done();
+}
+
+// ============== Yield Points ==============
+bool YieldPoint::await_ready() const noexcept {
+    return currentContext == nullptr || !currentContext->shouldYield();
+}
+
+YieldPoint yieldPoint() {
+    return YieldPoint{};
+}
+
+int submitTask(TaskExecutor& executor, PreemptibleTask task, int priority) {
+    auto coroutine = make_shared<PreemptibleTask>(move(task));
+    
+    return executor.submit([coroutine](TaskContext& context) {
+        TaskContext* outer = currentContext;
+        currentContext = &context;
+        bool finished = coroutine->resume();
+        currentContext = outer;
+        return finished;
+    }, priority);
+}
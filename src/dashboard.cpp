@@ -0,0 +1,158 @@
+// src/dashboard.cpp
+// Rate-limited terminal dashboard fed by scheduler snapshots
+
+#include "dashboard.h"
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+
+// ============== SchedulerSnapshot Implementation ==============
+SchedulerSnapshot::SchedulerSnapshot()
+    : time(0), runningPid(-1), runningRemaining(0), levels(0), levelNames(), levelLengths(),
+      totalProcesses(0), admitted(0), completed(0), busyTime(0), totalWaiting(0), totalTurnaround(0),
+      totalResponse(0), contextSwitches(0), switchTime(0) {}
+
+// ============== SnapshotChannel Implementation ==============
+SnapshotChannel::SnapshotChannel() : middle(1), backIndex(0), frontIndex(2), requested(false) {}
+
+SchedulerSnapshot& SnapshotChannel::back() {
+    return buffers[backIndex];
+}
+
+// Release makes the filled buffer visible to the consumer's acquire
+void SnapshotChannel::publish() {
+    backIndex = middle.exchange(backIndex | FRESH, memory_order_acq_rel) & ~FRESH;
+    requested.store(false, memory_order_relaxed);
+}
+
+void SnapshotChannel::request() {
+    requested.store(true, memory_order_relaxed);
+}
+
+bool SnapshotChannel::latest(SchedulerSnapshot& out) {
+    bool fresh = (middle.load(memory_order_relaxed) & FRESH) != 0;
+    if (fresh) {
+        frontIndex = middle.exchange(frontIndex, memory_order_acq_rel) & ~FRESH;
+    }
+    out = buffers[frontIndex];
+    return fresh;
+}
+
+// ============== Dashboard Implementation ==============
+Dashboard::Dashboard(ostream& stream, int framesPerSecond)
+    : out(stream), framePeriod(1000000 / max(framesPerSecond, 1)), running(false), frames(0),
+      hasPrevious(false) {}
+
+Dashboard::~Dashboard() {
+    stop();
+}
+
+SnapshotChannel& Dashboard::getChannel() {
+    return channel;
+}
+
+void Dashboard::start(const string& name) {
+    stop();
+    title = name;
+    hasPrevious = false;
+    running = true;
+    renderer = thread(&Dashboard::renderLoop, this);
+}
+
+void Dashboard::stop() {
+    if (!renderer.joinable()) return;
+    running = false;
+    renderer.join();
+    
+    SchedulerSnapshot last;
+    if (channel.latest(last)) {
+        render(last);
+    }
+}
+
+uint64_t Dashboard::getFrames() const {
+    return frames;
+}
+
+// Ask for the next snapshot, then draw the newest one at each frame
+void Dashboard::renderLoop() {
+    SchedulerSnapshot now;
+    auto next = chrono::steady_clock::now();
+    while (running) {
+        channel.request();
+        next += framePeriod;
+        this_thread::sleep_until(next);
+        if (channel.latest(now)) {
+            render(now);
+        }
+    }
+}
+
+void Dashboard::render(const SchedulerSnapshot& now) {
+    auto wall = chrono::steady_clock::now();
+    const SchedulerSnapshot& before = hasPrevious ? previous : SchedulerSnapshot();
+    double seconds = hasPrevious ? chrono::duration<double>(wall - previousWall).count() : 0.0;
+    long long elapsed = now.time - before.time;
+    uint64_t finished = now.completed - before.completed;
+    
+    auto share = [](long long part, long long whole) { return whole > 0 ? 100.0 * part / whole : 0.0; };
+    auto average = [](long long total, uint64_t count) { return count > 0 ? (double)total / count : 0.0; };
+    auto windowAverage = [&](long long total, long long earlier) -> string {
+        if (finished == 0) return "-";
+        ostringstream text;
+        text << fixed << setprecision(2) << (double)(total - earlier) / finished;
+        return text.str();
+    };
+    
+    // Composed first and written at once, so a frame never tears
+    ostringstream frame;
+    frame << fixed << setprecision(2);
+    frame << "\033[H\033[J";
+    frame << "========== Live: " << title << " ==========\n";
+    frame << "Time " << now.time;
+    if (seconds > 0.0) {
+        frame << " (" << setprecision(0) << elapsed / seconds << " units/s)" << setprecision(2);
+    }
+    frame << "   Frame " << frames + 1 << "\n";
+    
+    frame << "CPU: ";
+    if (now.runningPid >= 0) {
+        frame << "P" << now.runningPid << " (rem " << now.runningRemaining << ")\n";
+    } else {
+        frame << "IDLE\n";
+    }
+    uint64_t ready = 0;
+    frame << "Ready:";
+    for (int i = 0; i < now.levels; i++) {
+        frame << (i ? " |" : "") << " " << now.levelNames[i] << " " << now.levelLengths[i];
+        ready += now.levelLengths[i];
+    }
+    if (now.levels > 1) {
+        frame << "  (" << ready << " total)";
+    }
+    frame << "\n";
+    
+    const int width = 40;
+    int filled = now.totalProcesses ? (int)(width * now.completed / now.totalProcesses) : 0;
+    frame << "Progress: [" << string(filled, '#') << string(width - filled, '-') << "] "
+          << setprecision(1) << share(now.completed, now.totalProcesses) << "%  completed " << now.completed
+          << " / " << now.totalProcesses << ", in flight " << now.admitted - now.completed << "\n";
+    frame << "Utilization: " << share(now.busyTime, now.time) << "% overall, "
+          << share(now.busyTime - before.busyTime, elapsed) << "% this frame; switching "
+          << share(now.switchTime, now.time) << "% of time (" << now.contextSwitches << " switches)\n";
+    frame << setprecision(2);
+    frame << left << setw(16) << "Avg waiting" << right << setw(12) << average(now.totalWaiting, now.completed)
+          << " overall" << setw(12) << windowAverage(now.totalWaiting, before.totalWaiting) << " this frame\n";
+    frame << left << setw(16) << "Avg turnaround" << right << setw(12)
+          << average(now.totalTurnaround, now.completed) << " overall" << setw(12)
+          << windowAverage(now.totalTurnaround, before.totalTurnaround) << " this frame\n";
+    frame << left << setw(16) << "Avg response" << right << setw(12) << average(now.totalResponse, now.completed)
+          << " overall" << setw(12) << windowAverage(now.totalResponse, before.totalResponse) << " this frame\n";
+    
+    out << frame.str() << flush;
+    frames++;
+    previous = now;
+    previousWall = wall;
+    hasPrevious = true;
+}
@@ -0,0 +1,292 @@
+// src/executor.cpp
+// Work-stealing task executor driven by the RR, priority and MLFQ policies
+
+#include "executor.h"
+#include <climits>
+
+using namespace std;
+
+static const int PRIORITY_LEVELS = 6;
+static const int MLFQ_LEVELS = 3;
+
+// ============== TaskContext Implementation ==============
+bool TaskContext::shouldYield() const {
+    if (executor->policy == EXEC_PRIORITY) {
+        return executor->higherLevelWaiting(worker, level);
+    }
+    return chrono::steady_clock::now() >= deadline;
+}
+
+int TaskContext::getTaskId() const {
+    return taskId;
+}
+
+int TaskContext::getLevel() const {
+    return level;
+}
+
+// ============== TaskExecutor Implementation ==============
+TaskExecutor::Worker::Worker(size_t levelCount)
+    : levels(levelCount), queued(0), levelCounts(new atomic<size_t>[levelCount]()),
+      busy(false) {}
+
+TaskExecutor::TaskExecutor(ExecutorPolicy pol, size_t workerCount, int quantum)
+    : policy(pol), quantumMicros(quantum),
+      levelCount(pol == EXEC_PRIORITY ? PRIORITY_LEVELS : pol == EXEC_MLFQ ? MLFQ_LEVELS : 1),
+      epoch(chrono::steady_clock::now()), firstStart(epoch),
+      nextTaskId(1), nextWorker(0), outstanding(0), queuedTotal(0),
+      dispatchCount(0), stealCount(0), switchNanos(0), switchSamples(0),
+      stopping(false), running(false),
+      completedTasks(0), lastCompletion(0) {
+    for (size_t i = 0; i < max<size_t>(workerCount, 1); i++) {
+        workers.push_back(make_unique<Worker>(levelCount));
+    }
+}
+
+TaskExecutor::~TaskExecutor() {
+    shutdown();
+    
+    // Tasks submitted to an executor that was never started
+    for (auto& w : workers) {
+        for (auto& level : w->levels) {
+            for (Task* task : level) {
+                delete task;
+            }
+        }
+    }
+}
+
+int64_t TaskExecutor::now() const {
+    return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - epoch).count();
+}
+
+// Times in a task's Process record are ints. The executor measures in 64
+// bits and stores each time or duration here, so past INT_MAX microseconds
+// (about 35 minutes) it sticks at INT_MAX instead of wrapping.
+static int recordTime(int64_t micros) {
+    return (int)min<int64_t>(micros, INT_MAX);
+}
+
+int TaskExecutor::levelFor(int priority) const {
+    if (policy != EXEC_PRIORITY) return 0;
+    return priority < 0 ? 0 : min(priority, PRIORITY_LEVELS - 1);
+}
+
+int TaskExecutor::quantumFor(int level) const {
+    // MLFQ doubles the quantum per level like the simulator's 8/16/FCFS
+    if (policy == EXEC_MLFQ) {
+        return level == MLFQ_LEVELS - 1 ? INT_MAX : quantumMicros << level;
+    }
+    return quantumMicros;
+}
+
+int TaskExecutor::submit(TaskBody body, int priority) {
+    int id = nextTaskId++;
+    int64_t arrival = now();
+    Task* task = new Task{move(body), Process(id, recordTime(arrival), 0, priority), levelFor(priority),
+                          arrival, 0};
+    outstanding++;
+    push(nextWorker++ % workers.size(), task);
+    return id;
+}
+
+void TaskExecutor::push(size_t worker, Task* task) {
+    Worker& w = *workers[worker];
+    {
+        lock_guard<mutex> guard(w.lock);
+        w.levels[task->level].push_back(task);
+        w.levelCounts[task->level]++;
+        w.queued++;
+    }
+    if (queuedTotal++ == 0) {
+        lock_guard<mutex> guard(sleepLock);
+        sleepSignal.notify_all();
+    }
+}
+
+TaskExecutor::Task* TaskExecutor::popLocal(size_t worker) {
+    Worker& w = *workers[worker];
+    if (w.queued.load(memory_order_relaxed) == 0) return nullptr;
+    
+    lock_guard<mutex> guard(w.lock);
+    for (size_t level = 0; level < levelCount; level++) {
+        if (!w.levels[level].empty()) {
+            Task* task = w.levels[level].front();
+            w.levels[level].pop_front();
+            w.levelCounts[level]--;
+            w.queued--;
+            queuedTotal--;
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+TaskExecutor::Task* TaskExecutor::steal(size_t thief) {
+    for (size_t i = 1; i < workers.size(); i++) {
+        Worker& victim = *workers[(thief + i) % workers.size()];
+        if (victim.queued.load(memory_order_relaxed) == 0) continue;
+        
+        lock_guard<mutex> guard(victim.lock);
+        for (size_t level = 0; level < levelCount; level++) {
+            if (!victim.levels[level].empty()) {
+                Task* task = victim.levels[level].back();
+                victim.levels[level].pop_back();
+                victim.levelCounts[level]--;
+                victim.queued--;
+                queuedTotal--;
+                stealCount++;
+                return task;
+            }
+        }
+    }
+    return nullptr;
+}
+
+bool TaskExecutor::higherLevelWaiting(size_t worker, int level) const {
+    const Worker& w = *workers[worker];
+    for (int l = 0; l < level; l++) {
+        if (w.levelCounts[l].load(memory_order_relaxed) > 0) return true;
+    }
+    return false;
+}
+
+void TaskExecutor::dispatch(size_t worker, Task* task) {
+    TaskContext context;
+    context.executor = this;
+    context.worker = worker;
+    context.taskId = task->record.pid;
+    context.level = task->level;
+    
+    Worker& w = *workers[worker];
+    auto sliceStart = chrono::steady_clock::now();
+    if (w.busy) {
+        switchNanos += chrono::duration_cast<chrono::nanoseconds>(sliceStart - w.lastSliceEnd).count();
+        switchSamples++;
+    }
+    int64_t startMicros = now();
+    if (task->record.firstExecution) {
+        task->record.startTime = recordTime(startMicros);
+        task->record.responseTime = recordTime(startMicros - task->arrivalMicros);
+        task->record.firstExecution = false;
+    }
+    context.deadline = sliceStart + chrono::microseconds(quantumFor(task->level));
+    
+    bool finished = task->body(context);
+    
+    w.lastSliceEnd = chrono::steady_clock::now();
+    w.busy = true;
+    int64_t endMicros = now();
+    task->cpuMicros += endMicros - startMicros;
+    task->record.burstTime = recordTime(task->cpuMicros);
+    dispatchCount++;
+    
+    if (!finished) {
+        if (policy == EXEC_MLFQ && task->level < MLFQ_LEVELS - 1 &&
+            chrono::steady_clock::now() >= context.deadline) {
+            task->level++;
+        }
+        push(worker, task);
+        return;
+    }
+    
+    Process& record = task->record;
+    record.state = TERMINATED;
+    record.remainingTime = 0;
+    record.completionTime = recordTime(endMicros);
+    record.turnaroundTime = recordTime(endMicros - task->arrivalMicros);
+    record.waitingTime = recordTime(endMicros - task->arrivalMicros - task->cpuMicros);
+    
+    {
+        lock_guard<mutex> guard(doneLock);
+        completedRecords.push_back(record);
+        aggregate.add(record);
+        completedTasks++;
+        lastCompletion = max(lastCompletion, endMicros);
+    }
+    delete task;
+    
+    if (--outstanding == 0) {
+        lock_guard<mutex> guard(doneLock);
+        doneSignal.notify_all();
+    }
+}
+
+void TaskExecutor::workerLoop(size_t worker) {
+    while (!stopping.load()) {
+        Task* task = popLocal(worker);
+        if (task == nullptr) {
+            task = steal(worker);
+        }
+        
+        if (task != nullptr) {
+            dispatch(worker, task);
+            continue;
+        }
+        workers[worker]->busy = false;
+        
+        unique_lock<mutex> guard(sleepLock);
+        sleepSignal.wait_for(guard, chrono::milliseconds(1), [this]() {
+            return stopping.load() || queuedTotal.load() > 0;
+        });
+    }
+}
+
+void TaskExecutor::start() {
+    if (running) return;
+    running = true;
+    firstStart = chrono::steady_clock::now();
+    
+    for (size_t i = 0; i < workers.size(); i++) {
+        threads.emplace_back(&TaskExecutor::workerLoop, this, i);
+    }
+}
+
+void TaskExecutor::waitIdle() {
+    start();
+    
+    unique_lock<mutex> guard(doneLock);
+    doneSignal.wait(guard, [this]() { return outstanding.load() == 0; });
+}
+
+void TaskExecutor::shutdown() {
+    if (!running) return;
+    
+    waitIdle();
+    stopping = true;
+    {
+        lock_guard<mutex> guard(sleepLock);
+        sleepSignal.notify_all();
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    threads.clear();
+    running = false;
+    stopping = false;
+}
+
+size_t TaskExecutor::drainCompleted(vector<Process>& out) {
+    lock_guard<mutex> guard(doneLock);
+    size_t count = completedRecords.size();
+    out.insert(out.end(), completedRecords.begin(), completedRecords.end());
+    completedRecords.clear();
+    return count;
+}
+
+ExecutorReport TaskExecutor::report() {
+    lock_guard<mutex> guard(doneLock);
+    
+    ExecutorReport result;
+    result.metrics = aggregate;
+    result.completedTasks = completedTasks;
+    result.dispatches = dispatchCount.load();
+    result.steals = stealCount.load();
+    
+    int64_t startMicros = chrono::duration_cast<chrono::microseconds>(firstStart - epoch).count();
+    result.wallSeconds = max<int64_t>(0, lastCompletion - startMicros) / 1e6;
+    result.throughput = result.wallSeconds > 0.0 ? completedTasks / result.wallSeconds : 0.0;
+    size_t samples = switchSamples.load();
+    result.switchCostMicros = samples > 0 ? switchNanos.load() / 1000.0 / samples : 0.0;
+    return result;
+}
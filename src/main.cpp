@@ -1,14 +1,19 @@
 // src/main.cpp
-// Main program with interactive menu
+// Main program with interactive menu (batch mode when options are given)
 
 #include "scheduler.h"
+#include "batch.h"
 #include <iostream>
 #include <vector>
 #include <memory>
 
 using namespace std;
 
-int main() {
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        return batchMain(argc, argv);
+    }
+    
     cout << "========================================\n";
     cout << "  Advanced CPU Scheduler Simulator\n";
     cout << "========================================\n\n";
@@ -0,0 +1,325 @@
+// src/metrics.cpp
+// Streaming metric aggregation for completed processes
+
+#include "metrics.h"
+#include "scheduler.h"
+#include "checkpoint.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+// ============== StreamingStat Implementation ==============
+StreamingStat::StreamingStat()
+    : count(0), sum(0), sumSquares(0.0), minimum(0), maximum(0),
+      buckets(BUCKET_COUNT, 0) {}
+
+int StreamingStat::bucketIndex(long long value) {
+    if (value < SUB_BUCKETS) {
+        return value < 0 ? 0 : (int)value;
+    }
+    int exponent = 63 - __builtin_clzll((unsigned long long)value);
+    int shift = exponent - 4;
+    int sub = (int)(value >> shift) - SUB_BUCKETS;
+    return SUB_BUCKETS + shift * SUB_BUCKETS + sub;
+}
+
+long long StreamingStat::bucketValue(int index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    int shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+    int sub = (index - SUB_BUCKETS) % SUB_BUCKETS;
+    return (long long)(SUB_BUCKETS + sub) << shift;
+}
+
+void StreamingStat::add(long long value) {
+    if (count == 0 || value < minimum) minimum = value;
+    if (count == 0 || value > maximum) maximum = value;
+    count++;
+    sum += value;
+    sumSquares += (double)value * value;
+    buckets[bucketIndex(value)]++;
+}
+
+// Independent lanes let the compiler turn the sums and extremes into vector
+// reductions; only the histogram update stays scalar. The integer results
+// match add() exactly, sumSquares up to rounding
+void StreamingStat::addAll(const int32_t* values, size_t n) {
+    const int LANES = 8;
+    if (n == 0) return;
+    
+    long long sums[LANES] = {};
+    double squares[LANES] = {};
+    int32_t lows[LANES];
+    int32_t highs[LANES];
+    for (int j = 0; j < LANES; j++) {
+        lows[j] = highs[j] = values[0];
+    }
+    size_t whole = n - n % LANES;
+    for (size_t i = 0; i < whole; i += LANES) {
+        for (int j = 0; j < LANES; j++) {
+            int32_t value = values[i + j];
+            sums[j] += value;
+            squares[j] += (double)value * value;
+            lows[j] = min(lows[j], value);
+            highs[j] = max(highs[j], value);
+        }
+    }
+    for (size_t i = whole; i < n; i++) {
+        sums[0] += values[i];
+        squares[0] += (double)values[i] * values[i];
+        lows[0] = min(lows[0], values[i]);
+        highs[0] = max(highs[0], values[i]);
+    }
+    
+    int32_t low = *min_element(lows, lows + LANES);
+    int32_t high = *max_element(highs, highs + LANES);
+    if (count == 0 || low < minimum) minimum = low;
+    if (count == 0 || high > maximum) maximum = high;
+    count += n;
+    for (int j = 0; j < LANES; j++) {
+        sum += sums[j];
+        sumSquares += squares[j];
+    }
+    
+    // Bucket indices a chunk at a time: the exponent and top four mantissa
+    // bits of the (exact) double are the power of two and sub-bucket that
+    // bucketIndex() finds with a count-leading-zeros; masks, not branches,
+    // pick between that and the small-value buckets
+    const size_t CHUNK = 256;
+    size_t chunks = n - n % CHUNK;
+    int32_t indices[CHUNK];
+    for (size_t begin = 0; begin < chunks; begin += CHUNK) {
+        const int32_t* chunk = values + begin;
+        for (size_t i = 0; i < CHUNK; i++) {
+            uint64_t bits;
+            double value = chunk[i];
+            memcpy(&bits, &value, sizeof bits);
+            int32_t scaled = (int32_t)(bits >> 48) - ((1023 + 3) << 4);
+            int32_t small = chunk[i] & ~(chunk[i] >> 31);
+            int32_t isSmall = -(int32_t)(chunk[i] < SUB_BUCKETS);
+            indices[i] = (small & isSmall) | (scaled & ~isSmall);
+        }
+        for (size_t i = 0; i < CHUNK; i++) {
+            buckets[indices[i]]++;
+        }
+    }
+    for (size_t i = chunks; i < n; i++) {
+        buckets[bucketIndex(values[i])]++;
+    }
+}
+
+void StreamingStat::merge(const StreamingStat& other) {
+    if (other.count == 0) return;
+    if (count == 0 || other.minimum < minimum) minimum = other.minimum;
+    if (count == 0 || other.maximum > maximum) maximum = other.maximum;
+    count += other.count;
+    sum += other.sum;
+    sumSquares += other.sumSquares;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        buckets[i] += other.buckets[i];
+    }
+}
+
+uint64_t StreamingStat::getCount() const {
+    return count;
+}
+
+long long StreamingStat::getSum() const {
+    return sum;
+}
+
+double StreamingStat::getMean() const {
+    return count == 0 ? 0.0 : (double)sum / count;
+}
+
+double StreamingStat::getStdDev() const {
+    if (count == 0) return 0.0;
+    double mean = getMean();
+    double variance = sumSquares / count - mean * mean;
+    return variance > 0.0 ? sqrt(variance) : 0.0;
+}
+
+long long StreamingStat::getMin() const {
+    return minimum;
+}
+
+long long StreamingStat::getMax() const {
+    return maximum;
+}
+
+long long StreamingStat::getPercentile(double fraction) const {
+    if (count == 0) return 0;
+    
+    uint64_t rank = (uint64_t)ceil(fraction * count);
+    if (rank == 0) rank = 1;
+    
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            long long value = bucketValue(i);
+            if (value < minimum) return minimum;
+            return value > maximum ? maximum : value;
+        }
+    }
+    return maximum;
+}
+
+void StreamingStat::save(CheckpointWriter& out) const {
+    out.writeU64(count);
+    out.writeI64(sum);
+    out.writeDouble(sumSquares);
+    out.writeI64(minimum);
+    out.writeI64(maximum);
+    
+    uint32_t used = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        if (buckets[i] != 0) used++;
+    }
+    out.writeU32(used);
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        if (buckets[i] != 0) {
+            out.writeU32(i);
+            out.writeU64(buckets[i]);
+        }
+    }
+}
+
+void StreamingStat::load(CheckpointReader& in) {
+    count = in.readU64();
+    sum = in.readI64();
+    sumSquares = in.readDouble();
+    minimum = in.readI64();
+    maximum = in.readI64();
+    
+    fill(buckets.begin(), buckets.end(), 0);
+    uint32_t used = in.readU32();
+    for (uint32_t i = 0; i < used; i++) {
+        uint32_t index = in.readU32();
+        if (index >= (uint32_t)BUCKET_COUNT) {
+            throw runtime_error("checkpoint holds an invalid histogram bucket");
+        }
+        buckets[index] = in.readU64();
+    }
+}
+
+// ============== StreamingQuantile Implementation ==============
+StreamingQuantile::StreamingQuantile(double q)
+    : quantile(q), count(0), heights(), positions{1, 2, 3, 4, 5},
+      desired{1, 1 + 2 * q, 1 + 4 * q, 3 + 2 * q, 5}, increments{0, q / 2, q, (1 + q) / 2, 1} {}
+
+double StreamingQuantile::parabolic(int i, int d) const {
+    double n = positions[i], below = positions[i - 1], above = positions[i + 1];
+    return heights[i] + d / (above - below) *
+           ((n - below + d) * (heights[i + 1] - heights[i]) / (above - n) +
+            (above - n - d) * (heights[i] - heights[i - 1]) / (n - below));
+}
+
+double StreamingQuantile::linear(int i, int d) const {
+    return heights[i] + d * (heights[i + d] - heights[i]) / (positions[i + d] - positions[i]);
+}
+
+void StreamingQuantile::add(double value) {
+    if (count < 5) {
+        heights[count++] = value;
+        sort(heights, heights + count);
+        return;
+    }
+    count++;
+    
+    // Cell of the new value; the extreme markers track min and max
+    int cell;
+    if (value < heights[0]) {
+        heights[0] = value;
+        cell = 0;
+    } else if (value >= heights[4]) {
+        heights[4] = max(heights[4], value);
+        cell = 3;
+    } else {
+        cell = 0;
+        while (value >= heights[cell + 1]) cell++;
+    }
+    for (int i = cell + 1; i < 5; i++) {
+        positions[i]++;
+    }
+    for (int i = 0; i < 5; i++) {
+        desired[i] += increments[i];
+    }
+    
+    // Move the middle markers toward their desired positions
+    for (int i = 1; i < 4; i++) {
+        double offset = desired[i] - positions[i];
+        if ((offset >= 1 && positions[i + 1] - positions[i] > 1) ||
+            (offset <= -1 && positions[i - 1] - positions[i] < -1)) {
+            int d = offset > 0 ? 1 : -1;
+            double candidate = parabolic(i, d);
+            if (heights[i - 1] < candidate && candidate < heights[i + 1]) {
+                heights[i] = candidate;
+            } else {
+                heights[i] = linear(i, d);
+            }
+            positions[i] += d;
+        }
+    }
+}
+
+uint64_t StreamingQuantile::getCount() const {
+    return count;
+}
+
+double StreamingQuantile::get() const {
+    if (count == 0) return 0.0;
+    if (count <= 5) {
+        // Nearest rank among the sorted samples
+        size_t rank = (size_t)ceil(quantile * count);
+        return heights[rank > 0 ? rank - 1 : 0];
+    }
+    return heights[2];
+}
+
+void StreamingQuantile::save(CheckpointWriter& out) const {
+    out.writeU64(count);
+    for (int i = 0; i < 5; i++) {
+        out.writeDouble(heights[i]);
+        out.writeDouble(positions[i]);
+        out.writeDouble(desired[i]);
+    }
+}
+
+void StreamingQuantile::load(CheckpointReader& in) {
+    count = in.readU64();
+    for (int i = 0; i < 5; i++) {
+        heights[i] = in.readDouble();
+        positions[i] = in.readDouble();
+        desired[i] = in.readDouble();
+    }
+}
+
+// ============== MetricsAggregate Implementation ==============
+void MetricsAggregate::add(const Process& p) {
+    waiting.add(p.waitingTime);
+    turnaround.add(p.turnaroundTime);
+    response.add(p.responseTime);
+}
+
+void MetricsAggregate::merge(const MetricsAggregate& other) {
+    waiting.merge(other.waiting);
+    turnaround.merge(other.turnaround);
+    response.merge(other.response);
+}
+
+void MetricsAggregate::save(CheckpointWriter& out) const {
+    waiting.save(out);
+    turnaround.save(out);
+    response.save(out);
+}
+
+void MetricsAggregate::load(CheckpointReader& in) {
+    waiting.load(in);
+    turnaround.load(in);
+    response.load(in);
+}
@@ -0,0 +1,90 @@
+// src/phase_profiler.cpp
+// Per-phase timing of the simulation loop
+
+#include "phase_profiler.h"
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+using namespace std;
+
+static const char* PHASE_NAMES[PHASE_COUNT] = {"admit", "retire", "requeue", "select", "visualize", "checkpoint"};
+
+const char* phaseName(SchedulerPhase phase) {
+    return PHASE_NAMES[phase];
+}
+
+bool phaseProfilingEnabled() {
+#ifdef SCHEDULER_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+// The counter rate is measured against steady_clock over a short sleep
+double cycleCounterNanos() {
+    static const double nanos = [] {
+        auto wallStart = chrono::steady_clock::now();
+        uint64_t start = readCycleCounter();
+        this_thread::sleep_for(chrono::milliseconds(20));
+        uint64_t cycles = readCycleCounter() - start;
+        double elapsed = chrono::duration<double, nano>(chrono::steady_clock::now() - wallStart).count();
+        return cycles > 0 ? elapsed / cycles : 1.0;
+    }();
+    return nanos;
+}
+
+// ============== PhaseProfile Implementation ==============
+PhaseProfile::PhaseProfile() : cycles(), calls(), ticks(0) {}
+
+void PhaseProfile::merge(const PhaseProfile& other) {
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        cycles[i] += other.cycles[i];
+        calls[i] += other.calls[i];
+    }
+    ticks += other.ticks;
+}
+
+uint64_t PhaseProfile::totalCycles() const {
+    uint64_t total = 0;
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        total += cycles[i];
+    }
+    return total;
+}
+
+void PhaseProfile::writeReport(ostream& out) const {
+    double nanos = cycleCounterNanos();
+    uint64_t total = totalCycles();
+    
+    out << "\n========== Phase Profile ==========\n";
+    out << left << setw(12) << "Phase"
+        << right << setw(14) << "Calls"
+        << setw(12) << "Time(ms)"
+        << setw(9) << "Share"
+        << setw(12) << "ns/call" << "\n";
+    out << string(59, '-') << "\n";
+    out << fixed;
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        double ms = cycles[i] * nanos / 1e6;
+        out << left << setw(12) << PHASE_NAMES[i]
+            << right << setw(14) << calls[i]
+            << setw(12) << setprecision(3) << ms
+            << setw(8) << setprecision(1) << (total ? 100.0 * cycles[i] / total : 0.0) << "%"
+            << setw(12) << (calls[i] ? cycles[i] * nanos / calls[i] : 0.0) << "\n";
+    }
+    out << string(59, '-') << "\n";
+    out << "Ticks: " << ticks << ", profiled time: " << setprecision(3) << total * nanos / 1e6 << " ms\n";
+    out << "===================================\n";
+}
+
+void PhaseProfile::writeJson(ostream& out) const {
+    double nanos = cycleCounterNanos();
+    out << "{\"ticks\": " << ticks << ", \"phases\": {";
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        out << (i ? ", " : "") << "\"" << PHASE_NAMES[i] << "\": {\"calls\": " << calls[i]
+            << ", \"ns\": " << (uint64_t)(cycles[i] * nanos) << "}";
+    }
+    out << "}}";
+}
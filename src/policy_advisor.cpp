@@ -0,0 +1,240 @@
+// src/policy_advisor.cpp
+// Recommends a scheduling policy from a workload profile and prefix runs
+
+#include "policy_advisor.h"
+#include "arrival_order.h"
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+// ============== WorkloadProfile Implementation ==============
+WorkloadProfile::WorkloadProfile() : processes(0), firstArrival(0), lastArrival(0), priorities() {}
+
+void WorkloadProfile::add(const Process& p) {
+    if (processes == 0) {
+        firstArrival = p.arrivalTime;
+    } else {
+        gaps.add(p.arrivalTime - lastArrival);
+    }
+    lastArrival = p.arrivalTime;
+    processes++;
+    bursts.add(p.burstTime);
+    priorities[min(max(p.priority, 0), PRIORITY_CLASSES - 1)]++;
+}
+
+double WorkloadProfile::arrivalRate() const {
+    if (processes < 2 || lastArrival == firstArrival) return 0.0;
+    return (double)(processes - 1) / (lastArrival - firstArrival);
+}
+
+double WorkloadProfile::offeredLoad() const {
+    return arrivalRate() * bursts.getMean();
+}
+
+void WorkloadProfile::write(ostream& out) const {
+    auto variation = [](const StreamingStat& stat) {
+        return stat.getMean() > 0.0 ? stat.getStdDev() / stat.getMean() : 0.0;
+    };
+    
+    out << "\n========== Workload Profile ==========\n";
+    out << fixed << setprecision(2);
+    out << "Processes: " << processes << " arriving over [" << firstArrival << ", " << lastArrival << "]\n";
+    out << "Arrivals: " << setprecision(4) << arrivalRate() << " per time unit, inter-arrival CV "
+        << setprecision(2) << variation(gaps) << "\n";
+    out << "Bursts: mean " << bursts.getMean() << ", p50/p90/p99 " << bursts.getPercentile(0.50) << " / "
+        << bursts.getPercentile(0.90) << " / " << bursts.getPercentile(0.99) << ", max " << bursts.getMax()
+        << ", CV " << variation(bursts) << "\n";
+    out << "Priorities:";
+    for (int i = 0; i < PRIORITY_CLASSES; i++) {
+        out << " " << i << ": " << setprecision(1) << (processes ? 100.0 * priorities[i] / processes : 0.0) << "%";
+    }
+    out << "\nOffered load: " << setprecision(2) << offeredLoad()
+        << (offeredLoad() > 1.0 ? " (overloaded: queues grow without bound)" : "") << "\n";
+    out << "======================================\n";
+}
+
+// ============== Policy Advisor ==============
+string AdvisorCandidate::flags() const {
+    string text = "-a " + algorithm;
+    if (algorithmUsesQuantum(algorithm)) {
+        text += " -q " + to_string(quantum);
+    }
+    if (algorithmUsesPredictor(algorithm)) {
+        text += " --predictor " + predictor;
+    }
+    return text;
+}
+
+bool isAdvisorObjective(const string& objective) {
+    return objective == "waiting" || objective == "turnaround" || objective == "response" || objective == "p95";
+}
+
+static double objectiveValue(const RunResult& r, const string& objective) {
+    if (objective == "turnaround") return r.avgTurnaround;
+    if (objective == "response") return r.avgResponse;
+    if (objective == "p95") return (double)r.p95Turnaround;
+    return r.avgWaiting;
+}
+
+// Quanta to try: those asked for, plus the median and the 90th percentile
+// burst, so typical bursts finish within one or a few slices
+static vector<int> candidateQuanta(const BatchOptions& options, const WorkloadProfile& profile) {
+    vector<int> quanta = options.quanta;
+    for (double fraction : {0.50, 0.90}) {
+        quanta.push_back((int)max(1LL, min(profile.bursts.getPercentile(fraction), (long long)INT_MAX)));
+    }
+    sort(quanta.begin(), quanta.end());
+    quanta.erase(unique(quanta.begin(), quanta.end()), quanta.end());
+    return quanta;
+}
+
+static vector<AdvisorCandidate> candidatePolicies(const BatchOptions& options, const WorkloadProfile& profile) {
+    vector<AdvisorCandidate> candidates;
+    vector<int> quanta = candidateQuanta(options, profile);
+    int medianBurst = (int)max(1LL, profile.bursts.getPercentile(0.50));
+    for (const string algorithm : {"rr", "arr", "mlq", "pp", "npp", "mlfq", "sjf", "pmlfq"}) {
+        string predictor = algorithmUsesPredictor(algorithm) ? options.predictor : "";
+        if (algorithm == "arr") {
+            candidates.push_back(AdvisorCandidate{algorithm, medianBurst, predictor, RunResult()});
+        } else if (algorithmUsesQuantum(algorithm)) {
+            for (int quantum : quanta) {
+                candidates.push_back(AdvisorCandidate{algorithm, quantum, predictor, RunResult()});
+            }
+        } else {
+            candidates.push_back(AdvisorCandidate{algorithm, 0, predictor, RunResult()});
+        }
+    }
+    return candidates;
+}
+
+static void simulatePrefix(const BatchOptions& options, const vector<Process>& prefix, AdvisorCandidate& candidate) {
+    auto scheduler = makeScheduler(candidate.algorithm, candidate.quantum, options.contextSwitch, candidate.predictor);
+    scheduler->setTraceLevel(TRACE_NONE);
+    scheduler->setRetention(RETAIN_AGGREGATES);
+    for (const auto& p : prefix) {
+        scheduler->addProcess(p);
+    }
+    auto start = chrono::steady_clock::now();
+    scheduler->schedule();
+    double wallTimeMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    candidate.result = summarizeRun(*scheduler, candidate.quantum, wallTimeMs);
+}
+
+// The candidates are chosen from the prefix alone and start as soon as it
+// is complete, so they run while the rest of the workload is profiled.
+// Candidates share the prefix through the arrival-order cache. The threads
+// read the prefix, so they are joined before any error leaves this function.
+AdvisorReport adviseWorkload(const BatchOptions& options, const vector<Process>& workload) {
+    AdvisorReport report;
+    report.objective = options.objective;
+    
+    auto start = chrono::steady_clock::now();
+    vector<Process> prefix;
+    vector<thread> threads;
+    vector<exception_ptr> failures;
+    chrono::steady_clock::time_point launched;
+    auto launch = [&]() {
+        launched = chrono::steady_clock::now();
+        report.candidates = candidatePolicies(options, report.profile);
+        failures.resize(report.candidates.size());
+        for (size_t i = 0; i < report.candidates.size(); i++) {
+            threads.emplace_back([&, i]() {
+                try {
+                    simulatePrefix(options, prefix, report.candidates[i]);
+                } catch (...) {
+                    failures[i] = current_exception();
+                }
+            });
+        }
+    };
+    auto joinAll = [&]() {
+        for (auto& t : threads) {
+            if (t.joinable()) {
+                t.join();
+            }
+        }
+    };
+    auto observe = [&](const Process& p) {
+        report.profile.add(p);
+        if (prefix.size() < options.advisePrefix) {
+            prefix.push_back(p);
+            if (prefix.size() == options.advisePrefix) {
+                launch();
+            }
+        }
+    };
+    
+    try {
+        // Characterize everything in arrival order, without copying a file workload
+        if (options.generate) {
+            WorkloadGenerator generator(options.generator);
+            while (generator.hasNext()) {
+                observe(generator.next());
+            }
+        } else if (isArrivalSorted(workload)) {
+            for (const auto& p : workload) {
+                observe(p);
+            }
+        } else {
+            for (uint32_t index : arrivalOrder(workload)) {
+                observe(workload[index]);
+            }
+        }
+        if (prefix.empty()) {
+            throw runtime_error("workload contains no processes");
+        }
+        report.prefixProcesses = prefix.size();
+        report.profileMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if (threads.empty()) {
+            launch();
+        }
+    } catch (...) {
+        joinAll();
+        throw;
+    }
+    
+    joinAll();
+    for (const auto& failure : failures) {
+        if (failure) {
+            rethrow_exception(failure);
+        }
+    }
+    report.simulateMs = chrono::duration<double, milli>(chrono::steady_clock::now() - launched).count();
+    
+    stable_sort(report.candidates.begin(), report.candidates.end(),
+                [&](const AdvisorCandidate& a, const AdvisorCandidate& b) {
+                    return objectiveValue(a.result, report.objective) < objectiveValue(b.result, report.objective);
+                });
+    return report;
+}
+
+void writeAdvice(ostream& out, const AdvisorReport& report, OutputFormat format) {
+    vector<RunResult> results;
+    for (const auto& candidate : report.candidates) {
+        results.push_back(candidate.result);
+    }
+    if (format != FORMAT_TABLE) {
+        writeResults(out, results, format);
+        return;
+    }
+    
+    report.profile.write(out);
+    out << "\nCandidates on the first " << report.prefixProcesses << " processes, best "
+        << report.objective << " first:\n";
+    writeResults(out, results, format);
+    
+    const AdvisorCandidate& best = report.candidates.front();
+    const RunResult& r = best.result;
+    out << "\nRecommended: " << r.algorithm << "  (" << best.flags() << ")\n";
+    out << fixed << setprecision(2);
+    out << "Estimated: avg waiting " << r.avgWaiting << ", avg turnaround " << r.avgTurnaround
+        << ", avg response " << r.avgResponse << ", p95 turnaround " << r.p95Turnaround << "\n";
+    out << "Advisor: " << report.prefixProcesses << " of " << report.profile.processes << " processes ("
+        << setprecision(1) << 100.0 * report.prefixProcesses / report.profile.processes
+        << "%) per candidate; profile pass " << setprecision(3) << report.profileMs << " ms, "
+        << report.candidates.size() << " candidate runs " << report.simulateMs << " ms (overlapping)\n";
+}
@@ -0,0 +1,185 @@
+// src/result_cache.cpp
+// On-disk cache of batch run results, keyed by workload and configuration
+
+#include "result_cache.h"
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+using namespace std;
+
+static const char* ROWS_HEADER = "pid,arrival,burst,priority,start,completion,waiting,turnaround,response\n";
+
+static uint64_t fnv1a(const string& text) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// A synthetic workload is fully determined by its generator settings
+string workloadKey(const BatchOptions& options, const vector<Process>& workload) {
+    ostringstream key;
+    key << setprecision(17);
+    if (options.generate) {
+        const WorkloadConfig& g = options.generator;
+        key << "generate:" << g.count << ',' << g.seed << ',' << g.arrivals << ',' << g.arrivalRate
+            << ',' << g.burstFactor << ',' << g.meanPhaseLength << ',' << g.bursts << ',' << g.meanBurst
+            << ',' << g.paretoShape << ',' << g.lognormalSigma << ',' << g.maxBurst;
+        for (double weight : g.priorityWeights) {
+            key << ',' << weight;
+        }
+    } else if (streamsWorkload(options)) {
+        // Keyed like the same bursts loaded from a workload file
+        WorkloadHasher hasher;
+        importTrace(options.schedTracePath, options.schedTrace, [&](const Process& p) { hasher.add(p); });
+        key << "workload:" << hex << setw(16) << setfill('0') << hasher.digest()
+            << dec << ':' << hasher.count();
+    } else {
+        key << "workload:" << hex << setw(16) << setfill('0') << workloadHash(workload)
+            << dec << ':' << workload.size();
+    }
+    return key.str();
+}
+
+string runKey(const string& workload, const string& algorithm, int quantum, const BatchOptions& options) {
+    ostringstream key;
+    key << workload << " algorithm:" << algorithm << " quantum:" << quantum
+        << " switch:" << options.contextSwitch;
+    if (algorithmUsesPredictor(algorithm)) {
+        key << " predictor:" << options.predictor;
+    }
+    if (options.useTopology) {
+        const TopologyOptions& t = options.topology;
+        key << " topology:" << t.topology.describe() << ',' << t.placement << ',' << t.balanceInterval
+            << ',' << t.remoteImbalance << " costs:" << t.costs.coreMiss << ',' << t.costs.llcMiss
+            << ',' << t.costs.remoteMemory << ',' << t.costs.coreCacheProcesses
+            << ',' << t.costs.socketCacheProcesses;
+    }
+    return key.str();
+}
+
+// Entries appear atomically: written to a private name, then renamed
+static void publish(const string& temporary, const string& path) {
+    error_code error;
+    filesystem::rename(temporary, path, error);
+    if (error) {
+        filesystem::remove(temporary, error);
+        throw runtime_error("cannot write result cache entry '" + path + "'");
+    }
+}
+
+static string temporaryPath(const string& path) {
+    return path + ".tmp" + to_string(getpid());
+}
+
+// ============== ResultCache Implementation ==============
+ResultCache::ResultCache(const string& path) : directory(path) {
+    error_code error;
+    filesystem::create_directories(directory, error);
+    if (error || !filesystem::is_directory(directory)) {
+        throw runtime_error("cannot use result cache directory '" + directory + "'");
+    }
+}
+
+string ResultCache::entryPath(const string& key, const char* extension) const {
+    ostringstream name;
+    name << hex << setw(16) << setfill('0') << fnv1a(key) << extension;
+    return (filesystem::path(directory) / name.str()).string();
+}
+
+// The summary is published last, so it never points at missing rows
+void ResultCache::writeSummary(const string& key, const RunResult& result, bool hasRows) const {
+    string path = entryPath(key, ".run");
+    string temporary = temporaryPath(path);
+    {
+        ofstream out(temporary);
+        out << setprecision(17);
+        out << "result-cache " << RESULT_CACHE_VERSION << "\n" << key << "\n" << result.algorithm << "\n"
+            << result.predictor << "\n"
+            << result.quantum << ' ' << result.numProcesses << ' ' << result.avgWaiting << ' '
+            << result.avgTurnaround << ' ' << result.avgResponse << ' ' << result.p95Turnaround << ' '
+            << result.makespan << ' ' << result.cpus << ' ' << result.migrations << ' '
+            << result.cacheMisses << ' ' << result.contextSwitches << ' ' << result.switchTime << ' '
+            << result.adaptiveQuantum << ' ' << result.predictionMae << ' ' << result.predictionBias << ' '
+            << result.oracleWaiting << ' ' << hasRows << "\n";
+        if (!out) {
+            throw runtime_error("cannot write result cache entry '" + path + "'");
+        }
+    }
+    publish(temporary, path);
+}
+
+bool ResultCache::load(const string& key, RunResult& result, const string& rowsPath) const {
+    ifstream in(entryPath(key, ".run"));
+    if (!in) return false;
+    
+    string tag, storedKey;
+    uint32_t version = 0;
+    int hasRows = 0;
+    RunResult stored;
+    in >> tag >> version;
+    in.ignore(1);
+    if (tag != "result-cache" || version != RESULT_CACHE_VERSION) return false;
+    if (!getline(in, storedKey) || storedKey != key) return false;
+    if (!getline(in, stored.algorithm) || !getline(in, stored.predictor)) return false;
+    in >> stored.quantum >> stored.numProcesses >> stored.avgWaiting >> stored.avgTurnaround
+       >> stored.avgResponse >> stored.p95Turnaround >> stored.makespan >> stored.cpus
+       >> stored.migrations >> stored.cacheMisses >> stored.contextSwitches >> stored.switchTime
+       >> stored.adaptiveQuantum >> stored.predictionMae >> stored.predictionBias >> stored.oracleWaiting
+       >> hasRows;
+    if (!in) return false;
+    
+    if (!rowsPath.empty()) {
+        if (!hasRows) return false;
+        error_code error;
+        filesystem::copy_file(entryPath(key, ".csv"), rowsPath,
+                              filesystem::copy_options::overwrite_existing, error);
+        if (error) return false;
+    }
+    
+    stored.wallTimeMs = 0.0;
+    stored.cached = true;
+    result = stored;
+    return true;
+}
+
+void ResultCache::store(const string& key, const RunResult& result, const string& rowsPath) const {
+    bool hasRows = !rowsPath.empty();
+    if (hasRows) {
+        string rows = entryPath(key, ".csv");
+        string temporary = temporaryPath(rows);
+        error_code error;
+        filesystem::copy_file(rowsPath, temporary, filesystem::copy_options::overwrite_existing, error);
+        if (error) {
+            throw runtime_error("cannot copy '" + rowsPath + "' into the result cache");
+        }
+        publish(temporary, rows);
+    }
+    
+    writeSummary(key, result, hasRows);
+}
+
+void ResultCache::store(const string& key, const RunResult& result, const deque<Process>& processes) const {
+    string rows = entryPath(key, ".csv");
+    string temporary = temporaryPath(rows);
+    {
+        ofstream out(temporary);
+        out << ROWS_HEADER;
+        for (const auto& p : processes) {
+            out << p.pid << ',' << p.arrivalTime << ',' << p.burstTime << ',' << p.priority << ','
+                << p.startTime << ',' << p.completionTime << ',' << p.waitingTime << ','
+                << p.turnaroundTime << ',' << p.responseTime << '\n';
+        }
+        if (!out) {
+            throw runtime_error("cannot write result cache entry '" + rows + "'");
+        }
+    }
+    publish(temporary, rows);
+    writeSummary(key, result, true);
+}
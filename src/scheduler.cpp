@@ -2,6 +2,16 @@
 // Implementation of all scheduler classes
 
 #include "scheduler.h"
+#include "arrival_order.h"
+#include "checkpoint.h"
+#include "dashboard.h"
+#include "result_columns.h"
+#include <climits>
+#include <cmath>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <typeinfo>
 
 using namespace std;
 
@@ -20,35 +30,136 @@ void Process::display() const {
 
 // ============== Base Scheduler Implementation ==============
 Scheduler::Scheduler(int contextSwitch)
-    : currentTime(0), contextSwitchTime(contextSwitch),
-      totalWaitingTime(0), totalTurnaroundTime(0),
-      totalResponseTime(0), completedProcesses(0U) {}
+    : workload(make_shared<const vector<Process>>()), currentProcess(nullptr), timeSlice(0), nextArrival(0U),
+      preloadedProcesses(0U), workloadDigest(0U), workloadDigested(false), totalProcesses(0U), admittedProcesses(0U),
+      submissionSequence(0ULL), started(false), retention(RETAIN_ALL),
+      checkpointInterval(0), nextCheckpoint(0), currentTime(0), contextSwitchTime(contextSwitch),
+      costModel(nullptr), totalWaitingTime(0), totalTurnaroundTime(0),
+      totalResponseTime(0), contextSwitches(0U), switchTime(0), busyTime(0), completedProcesses(0U),
+      makespan(0), traceLevel(TRACE_FULL), fastForwardEnabled(true), snapshots(nullptr),
+      resultColumns(nullptr) {}
 
+// Once started the workload is frozen, so late additions arrive like submissions
 void Scheduler::addProcess(const Process& p) {
-    processes.push_back(p);
+    if (started) {
+        pendingArrivals.push(PendingArrival{p, submissionSequence++});
+    } else {
+        staged.push_back(p);
+    }
+    totalProcesses++;
+}
+
+void Scheduler::setTraceLevel(TraceLevel level) {
+    traceLevel = level;
+}
+
+void Scheduler::setRetention(RetentionMode mode) {
+    retention = mode;
+}
+
+void Scheduler::setSpillFile(const string& path) {
+    spillFile = make_unique<ofstream>(path);
+    if (!*spillFile) {
+        spillFile.reset();
+        throw runtime_error("cannot write spill file '" + path + "'");
+    }
+    spillPath = path;
+    *spillFile << "pid,arrival,burst,priority,start,completion,waiting,turnaround,response\n";
+}
+
+void Scheduler::setDispatchCostModel(DispatchCostModel* model) {
+    costModel = model;
+}
+
+void Scheduler::setFastForward(bool enabled) {
+    fastForwardEnabled = enabled;
+}
+
+// Predictions already made keep their values; the new model makes the rest
+void Scheduler::setBurstPredictor(unique_ptr<BurstPredictor> model) {
+    predictor = move(model);
+}
+
+void Scheduler::setSnapshotChannel(SnapshotChannel* channel) {
+    snapshots = channel;
+}
+
+// The level names come from the policy's countReady()
+void Scheduler::setResultColumns(ResultColumns* columns) {
+    resultColumns = columns;
+    if (columns == nullptr) return;
+    
+    SchedulerSnapshot levels;
+    countReady(levels);
+    columns->levels = levels.levels;
+    copy(levels.levelNames, levels.levelNames + SchedulerSnapshot::MAX_LEVELS, columns->levelNames);
+}
+
+int Scheduler::levelOf(const Process*) const {
+    return 0;
+}
+
+void Scheduler::publishSnapshot() {
+    if (snapshots == nullptr) return;
+    
+    SchedulerSnapshot& s = snapshots->back();
+    s.time = currentTime;
+    s.runningPid = currentProcess != nullptr ? currentProcess->pid : -1;
+    s.runningRemaining = currentProcess != nullptr ? currentProcess->remainingTime : 0;
+    s.levels = 0;
+    countReady(s);
+    s.totalProcesses = totalProcesses;
+    s.admitted = admittedProcesses;
+    s.completed = completedProcesses;
+    s.busyTime = busyTime;
+    s.totalWaiting = totalWaitingTime;
+    s.totalTurnaround = totalTurnaroundTime;
+    s.totalResponse = totalResponseTime;
+    s.contextSwitches = contextSwitches;
+    s.switchTime = switchTime;
+    snapshots->publish();
 }
 
 void Scheduler::displayMetrics() {
     cout << "\n========== Performance Metrics ==========\n";
     cout << fixed << setprecision(2);
     
-    for (const auto& p : processes) {
-        cout << "\nProcess P" << p.pid << ":\n";
-        cout << "  Waiting Time: " << p.waitingTime << " ms\n";
-        cout << "  Turnaround Time: " << p.turnaroundTime << " ms\n";
-        cout << "  Response Time: " << p.responseTime << " ms\n";
-        cout << "  Completion Time: " << p.completionTime << " ms\n";
+    if (retention == RETAIN_ALL) {
+        for (const auto& p : processes) {
+            cout << "\nProcess P" << p.pid << ":\n";
+            cout << "  Waiting Time: " << p.waitingTime << " ms\n";
+            cout << "  Turnaround Time: " << p.turnaroundTime << " ms\n";
+            cout << "  Response Time: " << p.responseTime << " ms\n";
+            cout << "  Completion Time: " << p.completionTime << " ms\n";
+        }
+    } else {
+        // Finished processes are no longer resident; report the aggregates
+        cout << "\nCompleted Processes: " << completedProcesses << "\n";
+        cout << "Turnaround p50/p95/p99: " << aggregate.turnaround.getPercentile(0.50)
+             << " / " << aggregate.turnaround.getPercentile(0.95)
+             << " / " << aggregate.turnaround.getPercentile(0.99) << " ms\n";
+        cout << "Waiting p50/p95/p99: " << aggregate.waiting.getPercentile(0.50)
+             << " / " << aggregate.waiting.getPercentile(0.95)
+             << " / " << aggregate.waiting.getPercentile(0.99) << " ms\n";
+    }
+    if (resultColumns != nullptr && resultColumns->size() > 0) {
+        analyzeResults(*resultColumns).write(cout);
     }
-    
-    double avgWaiting = (double)totalWaitingTime / processes.size();
-    double avgTurnaround = (double)totalTurnaroundTime / processes.size();
-    double avgResponse = (double)totalResponseTime / processes.size();
     
     cout << "\n========== Average Metrics ==========\n";
-    cout << "Average Waiting Time: " << avgWaiting << " ms\n";
-    cout << "Average Turnaround Time: " << avgTurnaround << " ms\n";
-    cout << "Average Response Time: " << avgResponse << " ms\n";
+    cout << "Average Waiting Time: " << getAverageWaitingTime() << " ms\n";
+    cout << "Average Turnaround Time: " << getAverageTurnaroundTime() << " ms\n";
+    cout << "Average Response Time: " << getAverageResponseTime() << " ms\n";
+    if (predictor && predictionError.count > 0) {
+        cout << "Burst Prediction (" << predictor->describe() << "): mean error "
+             << predictionError.meanAbsolute() << " ms, bias " << showpos
+             << predictionError.bias() << noshowpos << " ms\n";
+    }
     cout << "=========================================\n";
+    
+    if (phaseProfilingEnabled()) {
+        profile.writeReport(cout);
+    }
 }
 
 void Scheduler::visualizeQueue(const deque<Process*>& readyQueue, Process* running) {
@@ -73,7 +184,9 @@ void Scheduler::visualizeQueue(const deque<Process*>& readyQueue, Process* runni
             utilization++;
         }
     }
-    cout << " | Utilization: " << (utilization * 100 / processes.size()) << "%\n";
+    size_t total = processes.size() + (preloadedProcesses - nextArrival);
+    if (total == 0) total = 1;
+    cout << " | Utilization: " << (utilization * 100 / total) << "%\n";
 }
 
 void Scheduler::displayProcessStates() {
@@ -81,7 +194,10 @@ void Scheduler::displayProcessStates() {
     cout << "| PID | State | Burst  | Remaining | Queue |\n";
     cout << "+-----+-------+--------+-----------+-------+\n";
     
-    for (const auto& p : processes) {
+    // Admitted slots first, then the workload still waiting to arrive
+    for (size_t i = 0; i < processes.size() + (preloadedProcesses - nextArrival); i++) {
+        const Process& p = i < processes.size() ? processes[i]
+                                                : (*workload)[nextArrival + i - processes.size()];
         cout << "| P" << p.pid << "  | ";
         
         switch(p.state) {
@@ -105,566 +221,1480 @@ void Scheduler::displayProcessStates() {
 }
 
 double Scheduler::getAverageWaitingTime() const {
-    return (double)totalWaitingTime / processes.size();
+    if (completedProcesses == 0) return 0.0;
+    return (double)totalWaitingTime / completedProcesses;
 }
 
 double Scheduler::getAverageTurnaroundTime() const {
-    return (double)totalTurnaroundTime / processes.size();
+    if (completedProcesses == 0) return 0.0;
+    return (double)totalTurnaroundTime / completedProcesses;
 }
 
 double Scheduler::getAverageResponseTime() const {
-    return (double)totalResponseTime / processes.size();
+    if (completedProcesses == 0) return 0.0;
+    return (double)totalResponseTime / completedProcesses;
 }
 
-// ============== Round Robin Implementation ==============
-RoundRobinScheduler::RoundRobinScheduler(int quantum, int contextSwitch)
-    : Scheduler(contextSwitch), timeQuantum(quantum) {}
+size_t Scheduler::getProcessCount() const {
+    return totalProcesses;
+}
 
-void RoundRobinScheduler::schedule() {
-    cout << "\n========== Round Robin Scheduling (Quantum=" << timeQuantum << ") ==========\n";
-    deque<Process*> readyQueue;
-    Process* currentProcess = nullptr;
-    int timeSlice = 0;
-    
-    sort(processes.begin(), processes.end(), 
-         [](const Process& a, const Process& b) { return a.arrivalTime < b.arrivalTime; });
-    
-    size_t nextArrival = 0;
-    
-    while (completedProcesses < processes.size()) {
-        // Add newly arrived processes
-        while (nextArrival < processes.size() && 
-               processes[nextArrival].arrivalTime <= currentTime) {
-            processes[nextArrival].state = READY;
-            readyQueue.push_back(&processes[nextArrival]);
-            nextArrival++;
-        }
-        
-        // Context switch if needed
-        if (currentProcess != nullptr) {
-            if (currentProcess->remainingTime == 0) {
-                currentProcess->state = TERMINATED;
-                currentProcess->completionTime = currentTime;
-                currentProcess->turnaroundTime = currentTime - currentProcess->arrivalTime;
-                currentProcess->waitingTime = currentProcess->turnaroundTime - currentProcess->burstTime;
-                
-                totalWaitingTime += currentProcess->waitingTime;
-                totalTurnaroundTime += currentProcess->turnaroundTime;
-                totalResponseTime += currentProcess->responseTime;
-                
-                completedProcesses++;
-                currentProcess = nullptr;
-                timeSlice = 0;
-                
-                if (!readyQueue.empty()) {
-                    currentTime += contextSwitchTime;
-                }
-            } else if (timeSlice >= timeQuantum) {
-                currentProcess->state = READY;
-                readyQueue.push_back(currentProcess);
-                currentProcess = nullptr;
-                timeSlice = 0;
-                currentTime += contextSwitchTime;
-            }
-        }
-        
-        // Select next process
-        if (currentProcess == nullptr && !readyQueue.empty()) {
-            currentProcess = readyQueue.front();
-            readyQueue.pop_front();
-            currentProcess->state = RUNNING;
-            
-            if (currentProcess->firstExecution) {
-                currentProcess->responseTime = currentTime - currentProcess->arrivalTime;
-                currentProcess->startTime = currentTime;
-                currentProcess->firstExecution = false;
-            }
-            timeSlice = 0;
-        }
-        
-        visualizeQueue(readyQueue, currentProcess);
-        
-        // Display detailed state every 5 time units
-        if (currentTime % 5 == 0) {
-            displayProcessStates();
-        }
-        
-        if (currentProcess != nullptr) {
-            currentProcess->remainingTime--;
-            timeSlice++;
-        }
-        
-        currentTime++;
-        
-        if (currentProcess == nullptr && readyQueue.empty() && nextArrival < processes.size()) {
-            currentTime = processes[nextArrival].arrivalTime;
-        }
-    }
-    
-    displayMetrics();
+size_t Scheduler::getCompletedCount() const {
+    return completedProcesses;
 }
 
-// ============== Preemptive Priority Implementation ==============
-PreemptivePriorityScheduler::PreemptivePriorityScheduler(int contextSwitch)
-    : Scheduler(contextSwitch) {}
+size_t Scheduler::getInFlightCount() const {
+    return admittedProcesses - completedProcesses;
+}
 
-void PreemptivePriorityScheduler::schedule() {
-    cout << "\n========== Preemptive Priority Scheduling (Lower number = Higher priority) ==========\n";
-    
-    auto comparePriority = [](Process* a, Process* b) {
-        if (a->priority == b->priority) {
-            return a->arrivalTime > b->arrivalTime;
-        }
-        return a->priority > b->priority;
-    };
-    
-    priority_queue<Process*, vector<Process*>, decltype(comparePriority)> readyQueue(comparePriority);
-    Process* currentProcess = nullptr;
+int Scheduler::getCurrentTime() const {
+    return currentTime;
+}
+
+int Scheduler::getMakespan() const {
+    return makespan;
+}
+
+size_t Scheduler::getContextSwitchCount() const {
+    return contextSwitches;
+}
+
+long long Scheduler::getSwitchTime() const {
+    return switchTime;
+}
+
+size_t Scheduler::getResidentCount() const {
+    return processes.size() - freeSlots.size();
+}
+
+const MetricsAggregate& Scheduler::getAggregate() const {
+    return aggregate;
+}
+
+const PhaseProfile& Scheduler::getPhaseProfile() const {
+    return profile;
+}
+
+const deque<Process>& Scheduler::getRetainedProcesses() const {
+    return processes;
+}
+
+const BurstPredictor* Scheduler::getBurstPredictor() const {
+    return predictor.get();
+}
+
+const PredictionError& Scheduler::getPredictionError() const {
+    return predictionError;
+}
+
+// ============== Simulation Engine ==============
+void Scheduler::start() {
+    if (started) return;
+    started = true;
     
-    sort(processes.begin(), processes.end(), 
-         [](const Process& a, const Process& b) { return a.arrivalTime < b.arrivalTime; });
+    workload = sortedWorkload(move(staged));
+    staged.clear();
+    preloadedProcesses = workload->size();
+}
+
+// The online API hands finished processes out instead of keeping them
+void Scheduler::enterOnlineMode() {
+    if (retention == RETAIN_ALL) {
+        retention = RETAIN_RECORDS;
+    }
+}
+
+void Scheduler::run() {
+    start();
+    while (hasWork()) {
+        runTick();
+        skipIdle(INT_MAX);
+        checkpointIfDue();
+    }
+}
+
+void Scheduler::runTick(int horizon) {
+    PROFILE_TICK(profile);
+    fastForward(horizon);
     
-    size_t nextArrival = 0;
+    // Add newly arrived processes
+    {
+        PROFILE_PHASE(profile, PHASE_ADMIT);
+        admitArrivals();
+    }
     
-    while (completedProcesses < processes.size()) {
-        while (nextArrival < processes.size() && 
-               processes[nextArrival].arrivalTime <= currentTime) {
-            processes[nextArrival].state = READY;
-            readyQueue.push(&processes[nextArrival]);
-            
-            if (currentProcess != nullptr && 
-                processes[nextArrival].priority < currentProcess->priority) {
-                currentProcess->state = READY;
-                readyQueue.push(currentProcess);
-                currentProcess = nullptr;
-                currentTime += contextSwitchTime;
+    // Context switch if needed
+    if (currentProcess != nullptr) {
+        if (currentProcess->remainingTime == 0) {
+            {
+                PROFILE_PHASE(profile, PHASE_RETIRE);
+                retire(currentProcess);
             }
-            nextArrival++;
-        }
-        
-        if (currentProcess != nullptr && currentProcess->remainingTime == 0) {
-            currentProcess->state = TERMINATED;
-            currentProcess->completionTime = currentTime;
-            currentProcess->turnaroundTime = currentTime - currentProcess->arrivalTime;
-            currentProcess->waitingTime = currentProcess->turnaroundTime - currentProcess->burstTime;
-            
-            totalWaitingTime += currentProcess->waitingTime;
-            totalTurnaroundTime += currentProcess->turnaroundTime;
-            totalResponseTime += currentProcess->responseTime;
-            
-            completedProcesses++;
             currentProcess = nullptr;
+            timeSlice = 0;
             
-            if (!readyQueue.empty()) {
-                currentTime += contextSwitchTime;
+            if (hasReady()) {
+                chargeContextSwitch();
             }
+        } else if (quantumExpired()) {
+            PROFILE_PHASE(profile, PHASE_REQUEUE);
+            currentProcess->state = READY;
+            onQuantumExpired(currentProcess);
+            currentProcess = nullptr;
+            timeSlice = 0;
+            chargeContextSwitch();
         }
+    }
+    
+    // Select next process
+    if (currentProcess == nullptr) {
+        PROFILE_PHASE(profile, PHASE_SELECT);
+        currentProcess = selectNext();
         
-        if (currentProcess == nullptr && !readyQueue.empty()) {
-            currentProcess = const_cast<Process*>(readyQueue.top());
-            readyQueue.pop();
+        if (currentProcess != nullptr) {
             currentProcess->state = RUNNING;
+            if (costModel != nullptr) {
+                currentTime += costModel->dispatchPenalty(*currentProcess);
+            }
             
             if (currentProcess->firstExecution) {
                 currentProcess->responseTime = currentTime - currentProcess->arrivalTime;
                 currentProcess->startTime = currentTime;
                 currentProcess->firstExecution = false;
             }
+            timeSlice = 0;
         }
-        
-        deque<Process*> queueCopy;
-        auto tempQueue = readyQueue;
-        while (!tempQueue.empty()) {
-            queueCopy.push_back(const_cast<Process*>(tempQueue.top()));
-            tempQueue.pop();
-        }
-        visualizeQueue(queueCopy, currentProcess);
+    }
+    
+    if (traceLevel == TRACE_FULL) {
+        PROFILE_PHASE(profile, PHASE_VISUALIZE);
+        traceTick();
         
         // Display detailed state every 5 time units
         if (currentTime % 5 == 0) {
             displayProcessStates();
         }
-        
-        if (currentProcess != nullptr) {
-            currentProcess->remainingTime--;
-        }
-        
-        currentTime++;
-        
-        if (currentProcess == nullptr && readyQueue.empty() && nextArrival < processes.size()) {
-            currentTime = processes[nextArrival].arrivalTime;
-        }
     }
     
-    displayMetrics();
-}
-
-// ============== Non-Preemptive Priority Implementation ==============
-NonPreemptivePriorityScheduler::NonPreemptivePriorityScheduler(int contextSwitch)
-    : Scheduler(contextSwitch) {}
-
-void NonPreemptivePriorityScheduler::schedule() {
-    cout << "\n========== Non-Preemptive Priority Scheduling (Lower number = Higher priority) ==========\n";
+    if (currentProcess != nullptr) {
+        currentProcess->remainingTime--;
+        timeSlice++;
+        busyTime++;
+    }
     
-    auto comparePriority = [](Process* a, Process* b) {
-        if (a->priority == b->priority) {
-            return a->arrivalTime > b->arrivalTime;
-        }
-        return a->priority > b->priority;
-    };
+    currentTime++;
     
-    priority_queue<Process*, vector<Process*>, decltype(comparePriority)> readyQueue(comparePriority);
-    Process* currentProcess = nullptr;
+    if (snapshots != nullptr && snapshots->wanted()) {
+        publishSnapshot();
+    }
+}
+
+// A steady rotation is n slices of quantum + switch cost, after which the
+// queue order is back where it started and every member has run one
+// quantum. Whole rotations are applied at once while every member keeps at
+// least one unit left (so none completes) and they end before anything
+// else could happen: an arrival, or the horizon of advanceUntil(). Per-tick
+// tracing and dispatch penalties need every slice, so they run tick by tick.
+// The profile counts each skipped slice as one requeue.
+void Scheduler::fastForward(int horizon) {
+    if (!fastForwardEnabled || traceLevel == TRACE_FULL || costModel != nullptr) return;
+    if (currentProcess == nullptr || currentProcess->remainingTime == 0 || !quantumExpired()) return;
     
-    sort(processes.begin(), processes.end(), 
-         [](const Process& a, const Process& b) { return a.arrivalTime < b.arrivalTime; });
+    const deque<Process*>* cycle = nullptr;
+    int quantum = steadyRotation(cycle);
+    if (quantum <= 0) return;
     
-    size_t nextArrival = 0;
+    long long members = (long long)cycle->size() + 1;
+    long long slice = quantum + contextSwitchTime;
+    int least = currentProcess->remainingTime;
+    for (const Process* p : *cycle) {
+        least = min(least, p->remainingTime);
+    }
+    // The tick at the horizon belongs to the caller; an arrival is admitted
+    // by the tick that starts at its time, so that tick may follow directly
+    long long limit = min<long long>((long long)horizon - 1, nextArrivalTime());
+    long long rounds = min<long long>((least - 1) / quantum, (limit - currentTime) / (members * slice));
+    if (rounds <= 0) return;
+    PROFILE_PHASE_CALLS(profile, PHASE_REQUEUE, rounds * members);
     
-    while (completedProcesses < processes.size()) {
-        while (nextArrival < processes.size() && 
-               processes[nextArrival].arrivalTime <= currentTime) {
-            processes[nextArrival].state = READY;
-            readyQueue.push(&processes[nextArrival]);
-            nextArrival++;
-        }
-        
-        if (currentProcess != nullptr && currentProcess->remainingTime == 0) {
-            currentProcess->state = TERMINATED;
-            currentProcess->completionTime = currentTime;
-            currentProcess->turnaroundTime = currentTime - currentProcess->arrivalTime;
-            currentProcess->waitingTime = currentProcess->turnaroundTime - currentProcess->burstTime;
-            
-            totalWaitingTime += currentProcess->waitingTime;
-            totalTurnaroundTime += currentProcess->turnaroundTime;
-            totalResponseTime += currentProcess->responseTime;
-            
-            completedProcesses++;
-            currentProcess = nullptr;
-            
-            if (!readyQueue.empty()) {
-                currentTime += contextSwitchTime;
-            }
-        }
-        
-        if (currentProcess == nullptr && !readyQueue.empty()) {
-            currentProcess = const_cast<Process*>(readyQueue.top());
-            readyQueue.pop();
-            currentProcess->state = RUNNING;
-            
-            currentProcess->responseTime = currentTime - currentProcess->arrivalTime;
-            currentProcess->startTime = currentTime;
-            currentProcess->firstExecution = false;
-        }
-        
-        deque<Process*> queueCopy;
-        auto tempQueue = readyQueue;
-        while (!tempQueue.empty()) {
-            queueCopy.push_back(const_cast<Process*>(tempQueue.top()));
-            tempQueue.pop();
-        }
-        visualizeQueue(queueCopy, currentProcess);
-        
-        // Display detailed state every 5 time units
-        if (currentTime % 5 == 0) {
-            displayProcessStates();
+    // Members that never ran are first dispatched during the first rotation
+    int consumed = (int)rounds * quantum;
+    long long dispatch = (long long)currentTime + contextSwitchTime;
+    for (Process* p : *cycle) {
+        if (p->firstExecution) {
+            p->startTime = (int)dispatch;
+            p->responseTime = (int)dispatch - p->arrivalTime;
+            p->firstExecution = false;
         }
+        p->remainingTime -= consumed;
+        dispatch += slice;
+    }
+    currentProcess->remainingTime -= consumed;
+    
+    currentTime += (int)(rounds * members * slice);
+    busyTime += rounds * members * quantum;
+    contextSwitches += rounds * members;
+    switchTime += rounds * members * contextSwitchTime;
+}
+
+void Scheduler::admitArrivals() {
+    while (true) {
+        bool preloadReady = nextArrival < preloadedProcesses &&
+                            (*workload)[nextArrival].arrivalTime <= currentTime;
+        bool pendingReady = !pendingArrivals.empty() &&
+                            pendingArrivals.top().process.arrivalTime <= currentTime;
+        if (!preloadReady && !pendingReady) break;
         
-        if (currentProcess != nullptr) {
-            currentProcess->remainingTime--;
+        Process* p;
+        if (preloadReady && (!pendingReady ||
+            (*workload)[nextArrival].arrivalTime <= pendingArrivals.top().process.arrivalTime)) {
+            p = claimSlot((*workload)[nextArrival++]);
+        } else {
+            p = claimSlot(pendingArrivals.top().process);
+            pendingArrivals.pop();
         }
         
-        currentTime++;
-        
-        if (currentProcess == nullptr && readyQueue.empty() && nextArrival < processes.size()) {
-            currentTime = processes[nextArrival].arrivalTime;
+        p->state = READY;
+        admittedProcesses++;
+        if (predictor) {
+            predictedBursts[p] = predictor->predict(*p);
         }
+        onArrival(p);
     }
-    
-    displayMetrics();
 }
 
-// ============== Multilevel Queue Implementation ==============
-MultilevelQueueScheduler::MultilevelQueueScheduler(int quantum, int contextSwitch)
-    : Scheduler(contextSwitch), timeQuantum(quantum) {}
+Process* Scheduler::claimSlot(const Process& arrival) {
+    if (freeSlots.empty()) {
+        processes.push_back(arrival);
+        return &processes.back();
+    }
+    Process* p = freeSlots.back();
+    freeSlots.pop_back();
+    *p = arrival;
+    return p;
+}
 
-void MultilevelQueueScheduler::schedule() {
-    cout << "\n========== Multilevel Queue Scheduling ==========\n";
-    cout << "System Queue (Priority 0-1) > Interactive Queue (Priority 2-3) > Batch Queue (Priority 4-5)\n";
-    
-    Process* currentProcess = nullptr;
-    int timeSlice = 0;
+void Scheduler::retire(Process* p) {
+    p->state = TERMINATED;
+    p->completionTime = currentTime;
+    p->turnaroundTime = currentTime - p->arrivalTime;
+    p->waitingTime = p->turnaroundTime - p->burstTime;
+    makespan = currentTime;
     
-    sort(processes.begin(), processes.end(), 
-         [](const Process& a, const Process& b) { return a.arrivalTime < b.arrivalTime; });
+    totalWaitingTime += p->waitingTime;
+    totalTurnaroundTime += p->turnaroundTime;
+    totalResponseTime += p->responseTime;
+    completedProcesses++;
+    aggregate.add(*p);
+    if (resultColumns) {
+        resultColumns->append(*p, levelOf(p));
+    }
     
-    size_t nextArrival = 0;
+    if (spillFile) {
+        *spillFile << p->pid << ',' << p->arrivalTime << ',' << p->burstTime << ','
+                   << p->priority << ',' << p->startTime << ',' << p->completionTime << ','
+                   << p->waitingTime << ',' << p->turnaroundTime << ',' << p->responseTime << '\n';
+    }
     
-    while (completedProcesses < processes.size()) {
-        while (nextArrival < processes.size() && 
-               processes[nextArrival].arrivalTime <= currentTime) {
-            processes[nextArrival].state = READY;
-            
-            if (processes[nextArrival].priority <= 1) {
-                systemQueue.push_back(&processes[nextArrival]);
-            } else if (processes[nextArrival].priority <= 3) {
-                interactiveQueue.push_back(&processes[nextArrival]);
-            } else {
-                batchQueue.push_back(&processes[nextArrival]);
-            }
-            nextArrival++;
-        }
-        
-        if (currentProcess != nullptr) {
-            if (currentProcess->remainingTime == 0) {
-                currentProcess->state = TERMINATED;
-                currentProcess->completionTime = currentTime;
-                currentProcess->turnaroundTime = currentTime - currentProcess->arrivalTime;
-                currentProcess->waitingTime = currentProcess->turnaroundTime - currentProcess->burstTime;
-                
-                totalWaitingTime += currentProcess->waitingTime;
-                totalTurnaroundTime += currentProcess->turnaroundTime;
-                totalResponseTime += currentProcess->responseTime;
-                
-                completedProcesses++;
-                currentProcess = nullptr;
-                timeSlice = 0;
-                
-                if (!systemQueue.empty() || !interactiveQueue.empty() || !batchQueue.empty()) {
-                    currentTime += contextSwitchTime;
-                }
-            } else if (timeSlice >= timeQuantum && currentProcess->priority > 1) {
-                currentProcess->state = READY;
-                
-                if (currentProcess->priority <= 3) {
-                    interactiveQueue.push_back(currentProcess);
-                } else {
-                    batchQueue.push_back(currentProcess);
-                }
-                
-                currentProcess = nullptr;
-                timeSlice = 0;
-                currentTime += contextSwitchTime;
-            }
-        }
-        
-        if (currentProcess == nullptr) {
-            if (!systemQueue.empty()) {
-                currentProcess = systemQueue.front();
-                systemQueue.pop_front();
-            } else if (!interactiveQueue.empty()) {
-                currentProcess = interactiveQueue.front();
-                interactiveQueue.pop_front();
-            } else if (!batchQueue.empty()) {
-                currentProcess = batchQueue.front();
-                batchQueue.pop_front();
-            }
-            
-            if (currentProcess != nullptr) {
-                currentProcess->state = RUNNING;
-                
-                if (currentProcess->firstExecution) {
-                    currentProcess->responseTime = currentTime - currentProcess->arrivalTime;
-                    currentProcess->startTime = currentTime;
-                    currentProcess->firstExecution = false;
-                }
-                timeSlice = 0;
-            }
-        }
-        
-        cout << "\n[Time " << currentTime << "]";
-        cout << " CPU: ";
-        if (currentProcess) {
-            cout << "P" << currentProcess->pid << "(rem:" << currentProcess->remainingTime << ")";
-        } else {
-            cout << "IDLE";
-        }
-        
-        cout << "\n  System Q: [";
-        for (size_t i = 0; i < systemQueue.size(); i++) {
-            cout << "P" << systemQueue[i]->pid << "(rem:" << systemQueue[i]->remainingTime << ")";
-            if (i < systemQueue.size() - 1) cout << ", ";
-        }
-        cout << "]";
-        
-        cout << " | Interactive Q: [";
-        for (size_t i = 0; i < interactiveQueue.size(); i++) {
-            cout << "P" << interactiveQueue[i]->pid << "(rem:" << interactiveQueue[i]->remainingTime << ")";
-            if (i < interactiveQueue.size() - 1) cout << ", ";
-        }
-        cout << "]";
-        
-        cout << " | Batch Q: [";
-        for (size_t i = 0; i < batchQueue.size(); i++) {
-            cout << "P" << batchQueue[i]->pid << "(rem:" << batchQueue[i]->remainingTime << ")";
-            if (i < batchQueue.size() - 1) cout << ", ";
-        }
-        cout << "]\n";
-        
-        // Display detailed state every 5 time units
-        if (currentTime % 5 == 0) {
-            displayProcessStates();
-        }
-        
-        if (currentProcess != nullptr) {
-            currentProcess->remainingTime--;
-            timeSlice++;
-        }
-        
-        currentTime++;
-        
-        if (currentProcess == nullptr && systemQueue.empty() && 
-            interactiveQueue.empty() && batchQueue.empty() && 
-            nextArrival < processes.size()) {
-            currentTime = processes[nextArrival].arrivalTime;
+    // The actual burst is only known now; score the prediction, then learn
+    if (predictor) {
+        auto predicted = predictedBursts.find(p);
+        if (predicted != predictedBursts.end()) {
+            predictionError.add(predicted->second, p->burstTime);
+            predictedBursts.erase(predicted);
         }
+        predictor->observe(*p);
+    }
+    
+    onRetire(p);
+    if (costModel != nullptr) {
+        costModel->processRetired(*p);
     }
     
-    displayMetrics();
+    if (retention == RETAIN_RECORDS) {
+        completedRecords.push_back(*p);
+    }
+    if (retention != RETAIN_ALL) {
+        freeSlots.push_back(p);
+    }
 }
 
-// ============== Multilevel Feedback Queue Implementation ==============
-MultilevelFeedbackQueueScheduler::MultilevelFeedbackQueueScheduler(int contextSwitch)
-    : Scheduler(contextSwitch) {}
+void Scheduler::chargeContextSwitch() {
+    currentTime += contextSwitchTime;
+    switchTime += contextSwitchTime;
+    contextSwitches++;
+}
 
-void MultilevelFeedbackQueueScheduler::schedule() {
-    cout << "\n========== Multilevel Feedback Queue Scheduling ==========\n";
-    cout << "Q0 (quantum=8) > Q1 (quantum=16) > Q2 (FCFS)\n";
-    
-    Process* currentProcess = nullptr;
-    int timeSlice = 0;
-    int currentQueueLevel = -1;
+void Scheduler::skipIdle(int limit) {
+    if (currentProcess == nullptr && !hasReady() && hasPendingArrival()) {
+        int next = nextArrivalTime();
+        if (next > currentTime) {
+            currentTime = max(currentTime, min(next, limit));
+        }
+    }
+}
+
+bool Scheduler::hasWork() const {
+    return currentProcess != nullptr || hasReady() || hasPendingArrival();
+}
+
+bool Scheduler::hasPendingArrival() const {
+    return nextArrival < preloadedProcesses || !pendingArrivals.empty();
+}
+
+int Scheduler::nextArrivalTime() const {
+    int next = INT_MAX;
+    if (nextArrival < preloadedProcesses) {
+        next = (*workload)[nextArrival].arrivalTime;
+    }
+    if (!pendingArrivals.empty()) {
+        next = min(next, pendingArrivals.top().process.arrivalTime);
+    }
+    return next;
+}
+
+void Scheduler::checkpointIfDue() {
+    if (checkpointInterval > 0 && currentTime >= nextCheckpoint) {
+        PROFILE_PHASE(profile, PHASE_CHECKPOINT);
+        saveCheckpoint(checkpointPath);
+        nextCheckpoint = currentTime + checkpointInterval;
+    }
+}
+
+void Scheduler::onArrival(Process* p) {
+    enqueue(p);
+}
+
+bool Scheduler::quantumExpired() const {
+    return false;
+}
+
+void Scheduler::onQuantumExpired(Process* p) {
+    enqueue(p);
+}
+
+void Scheduler::onRetire(Process*) {}
+
+int Scheduler::steadyRotation(const deque<Process*>*&) const {
+    return 0;
+}
+
+// A process admitted before the predictor was installed (or inherited by a
+// branch) is predicted on first use
+double Scheduler::expectedBurst(const Process* p) {
+    if (!predictor) return p->burstTime;
     
-    sort(processes.begin(), processes.end(), 
-         [](const Process& a, const Process& b) { return a.arrivalTime < b.arrivalTime; });
+    auto predicted = predictedBursts.find(p);
+    if (predicted == predictedBursts.end()) {
+        predicted = predictedBursts.emplace(p, predictor->predict(*p)).first;
+    }
+    return predicted->second;
+}
+
+// ============== Incremental (Online) API ==============
+void Scheduler::submit(const Process& p) {
+    enterOnlineMode();
+    pendingArrivals.push(PendingArrival{p, submissionSequence++});
+    totalProcesses++;
+}
+
+bool Scheduler::step() {
+    enterOnlineMode();
+    start();
+    if (!hasWork()) return false;
     
-    size_t nextArrival = 0;
+    runTick();
+    skipIdle(INT_MAX);
+    checkpointIfDue();
+    return hasWork();
+}
+
+void Scheduler::advanceUntil(int time) {
+    enterOnlineMode();
+    start();
     
-    while (completedProcesses < processes.size()) {
-        while (nextArrival < processes.size() && 
-               processes[nextArrival].arrivalTime <= currentTime) {
-            processes[nextArrival].state = READY;
-            queue0.push_back(&processes[nextArrival]);
-            processQueue[processes[nextArrival].pid] = 0;
-            nextArrival++;
-        }
-        
-        if (currentProcess != nullptr) {
-            if (currentProcess->remainingTime == 0) {
-                currentProcess->state = TERMINATED;
-                currentProcess->completionTime = currentTime;
-                currentProcess->turnaroundTime = currentTime - currentProcess->arrivalTime;
-                currentProcess->waitingTime = currentProcess->turnaroundTime - currentProcess->burstTime;
-                
-                totalWaitingTime += currentProcess->waitingTime;
-                totalTurnaroundTime += currentProcess->turnaroundTime;
-                totalResponseTime += currentProcess->responseTime;
-                
-                completedProcesses++;
-                currentProcess = nullptr;
-                timeSlice = 0;
-                currentQueueLevel = -1;
-                
-                if (!queue0.empty() || !queue1.empty() || !queue2.empty()) {
-                    currentTime += contextSwitchTime;
-                }
-            } else {
-                bool demote = false;
-                
-                if (currentQueueLevel == 0 && timeSlice >= quantum0) {
-                    demote = true;
-                    processQueue[currentProcess->pid] = 1;
-                    queue1.push_back(currentProcess);
-                } else if (currentQueueLevel == 1 && timeSlice >= quantum1) {
-                    demote = true;
-                    processQueue[currentProcess->pid] = 2;
-                    queue2.push_back(currentProcess);
-                }
-                
-                if (demote) {
-                    currentProcess->state = READY;
-                    currentProcess = nullptr;
-                    timeSlice = 0;
-                    currentQueueLevel = -1;
-                    currentTime += contextSwitchTime;
-                }
-            }
-        }
-        
-        if (currentProcess == nullptr) {
-            if (!queue0.empty()) {
-                currentProcess = queue0.front();
-                queue0.pop_front();
-                currentQueueLevel = 0;
-            } else if (!queue1.empty()) {
-                currentProcess = queue1.front();
-                queue1.pop_front();
-                currentQueueLevel = 1;
-            } else if (!queue2.empty()) {
-                currentProcess = queue2.front();
-                queue2.pop_front();
-                currentQueueLevel = 2;
-            }
-            
-            if (currentProcess != nullptr) {
-                currentProcess->state = RUNNING;
-                
-                if (currentProcess->firstExecution) {
-                    currentProcess->responseTime = currentTime - currentProcess->arrivalTime;
-                    currentProcess->startTime = currentTime;
-                    currentProcess->firstExecution = false;
-                }
-                timeSlice = 0;
-            }
+    while (currentTime < time) {
+        if (!hasWork()) {
+            currentTime = time;
+            break;
         }
         
-        cout << "\n[Time " << currentTime << "]";
-        cout << " CPU: ";
-        if (currentProcess) {
-            cout << "P" << currentProcess->pid << "(rem:" << currentProcess->remainingTime << ", Q" << currentQueueLevel << ")";
-        } else {
-            cout << "IDLE";
+        skipIdle(time);
+        if (currentTime >= time) break;
+        runTick(time);
+        checkpointIfDue();
+    }
+}
+
+size_t Scheduler::drainCompleted(vector<Process>& out) {
+    size_t count = completedRecords.size();
+    out.insert(out.end(), completedRecords.begin(), completedRecords.end());
+    completedRecords.clear();
+    return count;
+}
+
+bool Scheduler::detachReady(Process& out) {
+    if (retention == RETAIN_ALL) {
+        throw logic_error("detachReady() needs a retention mode that reuses slots");
+    }
+    vector<Process*> ready;
+    collectReady(ready);
+    if (ready.empty()) return false;
+    
+    Process* p = ready.back();
+    removeReady(p);
+    predictedBursts.erase(p);
+    out = *p;
+    freeSlots.push_back(p);
+    admittedProcesses--;
+    totalProcesses--;
+    return true;
+}
+
+// ============== Checkpoint / Resume ==============
+static const char* CHECKPOINT_MAGIC = "cpu-scheduler checkpoint";
+
+void Scheduler::setCheckpoint(const string& path, int interval) {
+    if (interval <= 0) {
+        throw invalid_argument("checkpoint interval must be positive");
+    }
+    checkpointPath = path;
+    checkpointInterval = interval;
+    nextCheckpoint = currentTime + interval;
+}
+
+// Written to a temporary file first so a crash never leaves a torn snapshot
+void Scheduler::saveCheckpoint(const string& path) {
+    string temp = path + ".tmp";
+    {
+        ofstream file(temp, ios::binary | ios::trunc);
+        if (!file) {
+            throw runtime_error("cannot write checkpoint '" + temp + "'");
         }
-        
-        cout << "\n  Q0: [";
-        for (size_t i = 0; i < queue0.size(); i++) {
-            cout << "P" << queue0[i]->pid << "(rem:" << queue0[i]->remainingTime << ")";
-            if (i < queue0.size() - 1) cout << ", ";
+        saveState(file);
+        file.close();
+        if (!file) {
+            throw runtime_error("cannot write checkpoint '" + temp + "'");
         }
-        cout << "]";
-        
-        cout << " | Q1: [";
-        for (size_t i = 0; i < queue1.size(); i++) {
-            cout << "P" << queue1[i]->pid << "(rem:" << queue1[i]->remainingTime << ")";
-            if (i < queue1.size() - 1) cout << ", ";
+    }
+    filesystem::rename(temp, path);
+}
+
+void Scheduler::restoreCheckpoint(const string& path) {
+    ifstream file(path, ios::binary);
+    if (!file) {
+        throw runtime_error("cannot read checkpoint '" + path + "'");
+    }
+    loadState(file);
+}
+
+void Scheduler::saveState(ostream& stream) {
+    start();
+    CheckpointWriter out(stream);
+    out.writeString(CHECKPOINT_MAGIC);
+    out.writeU32(CHECKPOINT_VERSION);
+    out.writeString(getName());
+    out.writeI32(contextSwitchTime);
+    saveEngine(out);
+    
+    // The learned predictor state; the kind must match on resume
+    out.writeString(predictor ? predictor->describe() : "");
+    if (predictor) {
+        predictor->save(out);
+    }
+    
+    // The spill file is cut back to this length on resume
+    if (spillFile) {
+        spillFile->flush();
+        out.writeString(spillPath);
+        out.writeU64((uint64_t)spillFile->tellp());
+    } else {
+        out.writeString("");
+    }
+    
+    saveQueues(out);
+    if (!stream) {
+        throw runtime_error("cannot write checkpoint");
+    }
+}
+
+void Scheduler::loadState(istream& stream) {
+    if (started) {
+        throw logic_error("checkpoints can only be loaded into a scheduler that has not run");
+    }
+    start();
+    
+    CheckpointReader in(stream);
+    if (in.readString() != CHECKPOINT_MAGIC) {
+        throw runtime_error("not a scheduler checkpoint");
+    }
+    if (in.readU32() != CHECKPOINT_VERSION) {
+        throw runtime_error("unsupported checkpoint version");
+    }
+    string name = in.readString();
+    if (name != getName()) {
+        throw runtime_error("checkpoint was taken with " + name + ", not " + getName());
+    }
+    if (in.readI32() != contextSwitchTime) {
+        throw runtime_error("checkpoint was taken with a different context switch cost");
+    }
+    loadEngine(in);
+    
+    string model = in.readString();
+    if (model != (predictor ? predictor->describe() : "")) {
+        throw runtime_error("checkpoint was taken with a different burst predictor");
+    }
+    if (predictor) {
+        predictor->load(in);
+    }
+    
+    string spill = in.readString();
+    if (!spill.empty()) {
+        uint64_t length = in.readU64();
+        error_code ec;
+        filesystem::resize_file(spill, length, ec);
+        if (ec) {
+            throw runtime_error("cannot resume spill file '" + spill + "': " + ec.message());
         }
-        cout << "]";
-        
-        cout << " | Q2: [";
-        for (size_t i = 0; i < queue2.size(); i++) {
-            cout << "P" << queue2[i]->pid << "(rem:" << queue2[i]->remainingTime << ")";
-            if (i < queue2.size() - 1) cout << ", ";
+        spillFile = make_unique<ofstream>(spill, ios::app);
+        if (!*spillFile) {
+            spillFile.reset();
+            throw runtime_error("cannot write spill file '" + spill + "'");
         }
-        cout << "]\n";
-        
-        // Display detailed state every 5 time units
-        if (currentTime % 5 == 0) {
-            displayProcessStates();
+        spillPath = spill;
+    }
+    
+    loadQueues(in);
+    if (checkpointInterval > 0) {
+        nextCheckpoint = currentTime + checkpointInterval;
+    }
+}
+
+// Hashed on first use: only checkpoints and branches need it
+uint64_t Scheduler::workloadFingerprint() const {
+    if (!workloadDigested) {
+        workloadDigest = workloadHash(*workload);
+        workloadDigested = true;
+    }
+    return workloadDigest;
+}
+
+// Everything but the policy queues, the configuration and the output files
+void Scheduler::saveEngine(CheckpointWriter& out) const {
+    out.writeU32(retention);
+    out.writeU64(preloadedProcesses);
+    out.writeU64(workloadFingerprint());
+    out.writeU64(nextArrival);
+    out.writeU64(processes.size());
+    for (const auto& p : processes) {
+        out.writeProcess(p);
+        out.bindSlot(&p);
+    }
+    out.writeSlots(freeSlots);
+    out.writeSlot(currentProcess);
+    
+    out.writeI32(timeSlice);
+    out.writeI32(currentTime);
+    out.writeI32(makespan);
+    out.writeU64(totalProcesses);
+    out.writeU64(admittedProcesses);
+    out.writeU64(completedProcesses);
+    out.writeU64(submissionSequence);
+    out.writeI64(totalWaitingTime);
+    out.writeI64(totalTurnaroundTime);
+    out.writeI64(totalResponseTime);
+    out.writeU64(contextSwitches);
+    out.writeI64(switchTime);
+    out.writeI64(busyTime);
+    
+    out.writeU64(predictedBursts.size());
+    for (const auto& entry : predictedBursts) {
+        out.writeSlot(entry.first);
+        out.writeDouble(entry.second);
+    }
+    out.writeU64(predictionError.count);
+    out.writeDouble(predictionError.absoluteSum);
+    out.writeDouble(predictionError.signedSum);
+    
+    auto pending = pendingArrivals;
+    out.writeU64(pending.size());
+    while (!pending.empty()) {
+        out.writeProcess(pending.top().process);
+        out.writeU64(pending.top().sequence);
+        pending.pop();
+    }
+    
+    out.writeU64(completedRecords.size());
+    for (const auto& p : completedRecords) {
+        out.writeProcess(p);
+    }
+    aggregate.save(out);
+}
+
+void Scheduler::loadEngine(CheckpointReader& in) {
+    uint32_t mode = in.readU32();
+    if (mode > RETAIN_AGGREGATES) {
+        throw runtime_error("checkpoint holds an invalid retention mode");
+    }
+    retention = (RetentionMode)mode;
+    
+    uint64_t count = in.readU64();
+    if (count != preloadedProcesses || in.readU64() != workloadFingerprint()) {
+        throw runtime_error("checkpoint was taken with a different workload");
+    }
+    nextArrival = in.readU64();
+    if (nextArrival > preloadedProcesses) {
+        throw runtime_error("checkpoint is corrupt");
+    }
+    uint64_t slots = in.readU64();
+    for (uint64_t i = 0; i < slots; i++) {
+        processes.push_back(Process(0, 0, 0));
+        in.readProcess(processes.back());
+        in.bindSlot(&processes.back());
+    }
+    in.readSlots(freeSlots);
+    currentProcess = in.readSlot();
+    
+    timeSlice = in.readI32();
+    currentTime = in.readI32();
+    makespan = in.readI32();
+    totalProcesses = in.readU64();
+    admittedProcesses = in.readU64();
+    completedProcesses = in.readU64();
+    submissionSequence = in.readU64();
+    totalWaitingTime = in.readI64();
+    totalTurnaroundTime = in.readI64();
+    totalResponseTime = in.readI64();
+    contextSwitches = in.readU64();
+    switchTime = in.readI64();
+    busyTime = in.readI64();
+    
+    uint64_t predictions = in.readU64();
+    for (uint64_t i = 0; i < predictions; i++) {
+        Process* slot = in.readSlot();
+        if (slot == nullptr) {
+            throw runtime_error("checkpoint is corrupt");
         }
-        
-        if (currentProcess != nullptr) {
-            currentProcess->remainingTime--;
-            timeSlice++;
+        predictedBursts[slot] = in.readDouble();
+    }
+    predictionError.count = in.readU64();
+    predictionError.absoluteSum = in.readDouble();
+    predictionError.signedSum = in.readDouble();
+    
+    uint64_t pending = in.readU64();
+    for (uint64_t i = 0; i < pending; i++) {
+        PendingArrival arrival{Process(0, 0, 0), 0};
+        in.readProcess(arrival.process);
+        arrival.sequence = in.readU64();
+        pendingArrivals.push(arrival);
+    }
+    
+    uint64_t records = in.readU64();
+    for (uint64_t i = 0; i < records; i++) {
+        Process p(0, 0, 0);
+        in.readProcess(p);
+        completedRecords.push_back(p);
+    }
+    aggregate.load(in);
+}
+
+// ============== What-If Branching ==============
+// The branch shares the source's sorted workload and copies only the
+// engine state through an in-memory snapshot, so a fork costs the same as
+// a checkpoint: proportional to the resident and pending processes.
+void Scheduler::branchFrom(Scheduler& source) {
+    if (started || !staged.empty() || !pendingArrivals.empty()) {
+        throw logic_error("branchFrom() needs a scheduler that has not run");
+    }
+    source.start();
+    workload = source.workload;
+    preloadedProcesses = source.preloadedProcesses;
+    workloadDigest = source.workloadFingerprint();
+    workloadDigested = true;
+    started = true;
+    
+    stringstream buffer;
+    CheckpointWriter out(buffer);
+    source.saveEngine(out);
+    bool samePolicy = typeid(*this) == typeid(source);
+    if (samePolicy) {
+        source.saveQueues(out);
+    } else {
+        // The running process goes back first so it is reselected when the
+        // new policy would have kept it; one that just finished stays put
+        // and is retired on the next tick
+        vector<Process*> ready;
+        if (source.currentProcess != nullptr && source.currentProcess->remainingTime > 0) {
+            ready.push_back(source.currentProcess);
         }
-        
-        currentTime++;
-        
-        if (currentProcess == nullptr && queue0.empty() && 
-            queue1.empty() && queue2.empty() && 
-            nextArrival < processes.size()) {
-            currentTime = processes[nextArrival].arrivalTime;
+        source.collectReady(ready);
+        out.writeSlots(ready);
+    }
+    
+    CheckpointReader in(buffer);
+    loadEngine(in);
+    
+    // A branch with the same kind of predictor carries on learning from the
+    // source's state; any other predictor starts over
+    bool sameModel = predictor && source.predictor && predictor->describe() == source.predictor->describe();
+    if (sameModel) {
+        stringstream model;
+        CheckpointWriter modelOut(model);
+        source.predictor->save(modelOut);
+        CheckpointReader modelIn(model);
+        predictor->load(modelIn);
+    } else {
+        predictedBursts.clear();
+        predictionError = PredictionError();
+    }
+    
+    if (samePolicy) {
+        loadQueues(in);
+    } else {
+        vector<Process*> ready;
+        in.readSlots(ready);
+        if (currentProcess != nullptr && currentProcess->remainingTime > 0) {
+            currentProcess = nullptr;
+        }
+        timeSlice = 0;
+        for (Process* p : ready) {
+            p->state = READY;
+            enqueue(p);
         }
     }
+    if (checkpointInterval > 0) {
+        nextCheckpoint = currentTime + checkpointInterval;
+    }
+}
+
+// ============== Round Robin Implementation ==============
+RoundRobinScheduler::RoundRobinScheduler(int quantum, int contextSwitch)
+    : Scheduler(contextSwitch), timeQuantum(quantum) {}
+
+string RoundRobinScheduler::getName() const {
+    return "Round Robin (q=" + to_string(timeQuantum) + ")";
+}
+
+void RoundRobinScheduler::schedule() {
+    if (traceLevel != TRACE_NONE) {
+        cout << "\n========== Round Robin Scheduling (Quantum=" << timeQuantum << ") ==========\n";
+    }
+    
+    run();
+    
+    if (traceLevel != TRACE_NONE) {
+        displayMetrics();
+    }
+}
+
+void RoundRobinScheduler::enqueue(Process* p) {
+    readyQueue.push_back(p);
+}
+
+Process* RoundRobinScheduler::selectNext() {
+    if (readyQueue.empty()) return nullptr;
+    
+    Process* next = readyQueue.front();
+    readyQueue.pop_front();
+    return next;
+}
+
+bool RoundRobinScheduler::hasReady() const {
+    return !readyQueue.empty();
+}
+
+bool RoundRobinScheduler::quantumExpired() const {
+    return timeSlice >= timeQuantum;
+}
+
+int RoundRobinScheduler::steadyRotation(const deque<Process*>*& cycle) const {
+    cycle = &readyQueue;
+    return timeQuantum;
+}
+
+void RoundRobinScheduler::traceTick() {
+    visualizeQueue(readyQueue, currentProcess);
+}
+
+void RoundRobinScheduler::saveQueues(CheckpointWriter& out) const {
+    out.writeSlots(readyQueue);
+}
+
+void RoundRobinScheduler::loadQueues(CheckpointReader& in) {
+    in.readSlots(readyQueue);
+}
+
+void RoundRobinScheduler::collectReady(vector<Process*>& out) const {
+    out.insert(out.end(), readyQueue.begin(), readyQueue.end());
+}
+
+void RoundRobinScheduler::removeReady(Process* p) {
+    readyQueue.erase(find(readyQueue.begin(), readyQueue.end(), p));
+}
+
+void RoundRobinScheduler::countReady(SchedulerSnapshot& out) const {
+    out.levels = 1;
+    out.levelNames[0] = "ready";
+    out.levelLengths[0] = readyQueue.size();
+}
+
+// ============== Adaptive Round Robin Implementation ==============
+AdaptiveQuantum::AdaptiveQuantum()
+    : minQuantum(1), maxQuantum(64), targetLatency(256), burstQuantile(0.8), maxSwitchOverhead(0.1) {}
+
+AdaptiveRoundRobinScheduler::AdaptiveRoundRobinScheduler(int initialQuantum, const AdaptiveQuantum& adaptive,
+                                                         int contextSwitch)
+    : RoundRobinScheduler(initialQuantum, contextSwitch), limits(adaptive),
+      bursts(adaptive.burstQuantile), currentQuantum(initialQuantum) {
+    if (limits.minQuantum < 1 || limits.maxQuantum < limits.minQuantum) {
+        throw invalid_argument("adaptive quantum limits must satisfy 1 <= min <= max");
+    }
+}
+
+string AdaptiveRoundRobinScheduler::getName() const {
+    return "Adaptive RR (q0=" + to_string(timeQuantum) + ")";
+}
+
+void AdaptiveRoundRobinScheduler::schedule() {
+    if (traceLevel != TRACE_NONE) {
+        cout << "\n========== Adaptive Round Robin Scheduling (Initial Quantum=" << timeQuantum << ") ==========\n";
+    }
+    
+    run();
+    
+    if (traceLevel != TRACE_NONE) {
+        displayMetrics();
+    }
+}
+
+Process* AdaptiveRoundRobinScheduler::selectNext() {
+    Process* next = RoundRobinScheduler::selectNext();
+    if (next == nullptr) return nullptr;
+    
+    // Slices shorter than floor would spend more than the overhead budget switching
+    int floor = limits.minQuantum;
+    if (limits.maxSwitchOverhead > 0.0) {
+        int budget = (int)ceil(contextSwitchTime * (1.0 - limits.maxSwitchOverhead) / limits.maxSwitchOverhead);
+        floor = max(floor, min(budget, limits.maxQuantum));
+    }
     
-    displayMetrics();
-}
\ No newline at end of file
+    int quantum = timeQuantum;
+    if (bursts.getCount() > 0) {
+        quantum = (int)lround(bursts.get());
+    }
+    int share = limits.targetLatency / (int)(readyQueue.size() + 1);
+    currentQuantum = clamp(min(quantum, share), floor, limits.maxQuantum);
+    return next;
+}
+
+bool AdaptiveRoundRobinScheduler::quantumExpired() const {
+    return timeSlice >= currentQuantum;
+}
+
+// The quantum changes with every dispatch, so rotations are not uniform
+int AdaptiveRoundRobinScheduler::steadyRotation(const deque<Process*>*&) const {
+    return 0;
+}
+
+void AdaptiveRoundRobinScheduler::onRetire(Process* p) {
+    bursts.add(p->burstTime);
+}
+
+int AdaptiveRoundRobinScheduler::getCurrentQuantum() const {
+    return currentQuantum;
+}
+
+void AdaptiveRoundRobinScheduler::saveQueues(CheckpointWriter& out) const {
+    RoundRobinScheduler::saveQueues(out);
+    out.writeI32(currentQuantum);
+    bursts.save(out);
+}
+
+void AdaptiveRoundRobinScheduler::loadQueues(CheckpointReader& in) {
+    RoundRobinScheduler::loadQueues(in);
+    currentQuantum = in.readI32();
+    bursts.load(in);
+}
+
+// ============== Priority Queue Helpers ==============
+static void removeFromHeap(PriorityReadyQueue& queue, Process* p) {
+    vector<Process*>& heap = queue.heap();
+    heap.erase(find(heap.begin(), heap.end(), p));
+    make_heap(heap.begin(), heap.end(), PriorityOrder());
+}
+
+// ============== Preemptive Priority Implementation ==============
+PreemptivePriorityScheduler::PreemptivePriorityScheduler(int contextSwitch)
+    : Scheduler(contextSwitch) {}
+
+string PreemptivePriorityScheduler::getName() const {
+    return "Preemptive Priority";
+}
+
+void PreemptivePriorityScheduler::schedule() {
+    if (traceLevel != TRACE_NONE) {
+        cout << "\n========== Preemptive Priority Scheduling (Lower number = Higher priority) ==========\n";
+    }
+    
+    run();
+    
+    if (traceLevel != TRACE_NONE) {
+        displayMetrics();
+    }
+}
+
+void PreemptivePriorityScheduler::onArrival(Process* p) {
+    readyQueue.push(p);
+    
+    // A process that finished this tick is retired below, not preempted
+    if (currentProcess != nullptr && currentProcess->remainingTime > 0 &&
+        p->priority < currentProcess->priority) {
+        currentProcess->state = READY;
+        readyQueue.push(currentProcess);
+        currentProcess = nullptr;
+        chargeContextSwitch();
+    }
+}
+
+void PreemptivePriorityScheduler::enqueue(Process* p) {
+    readyQueue.push(p);
+}
+
+Process* PreemptivePriorityScheduler::selectNext() {
+    if (readyQueue.empty()) return nullptr;
+    
+    Process* next = readyQueue.top();
+    readyQueue.pop();
+    return next;
+}
+
+bool PreemptivePriorityScheduler::hasReady() const {
+    return !readyQueue.empty();
+}
+
+void PreemptivePriorityScheduler::traceTick() {
+    deque<Process*> queueCopy;
+    auto tempQueue = readyQueue;
+    while (!tempQueue.empty()) {
+        queueCopy.push_back(tempQueue.top());
+        tempQueue.pop();
+    }
+    visualizeQueue(queueCopy, currentProcess);
+}
+
+void PreemptivePriorityScheduler::saveQueues(CheckpointWriter& out) const {
+    out.writeSlots(readyQueue.heap());
+}
+
+void PreemptivePriorityScheduler::loadQueues(CheckpointReader& in) {
+    in.readSlots(readyQueue.heap());
+}
+
+void PreemptivePriorityScheduler::collectReady(vector<Process*>& out) const {
+    auto tempQueue = readyQueue;
+    while (!tempQueue.empty()) {
+        out.push_back(tempQueue.top());
+        tempQueue.pop();
+    }
+}
+
+void PreemptivePriorityScheduler::removeReady(Process* p) {
+    removeFromHeap(readyQueue, p);
+}
+
+void PreemptivePriorityScheduler::countReady(SchedulerSnapshot& out) const {
+    out.levels = 1;
+    out.levelNames[0] = "ready";
+    out.levelLengths[0] = readyQueue.size();
+}
+
+// ============== Non-Preemptive Priority Implementation ==============
+NonPreemptivePriorityScheduler::NonPreemptivePriorityScheduler(int contextSwitch)
+    : Scheduler(contextSwitch) {}
+
+string NonPreemptivePriorityScheduler::getName() const {
+    return "Non-Preemptive Priority";
+}
+
+void NonPreemptivePriorityScheduler::schedule() {
+    if (traceLevel != TRACE_NONE) {
+        cout << "\n========== Non-Preemptive Priority Scheduling (Lower number = Higher priority) ==========\n";
+    }
+    
+    run();
+    
+    if (traceLevel != TRACE_NONE) {
+        displayMetrics();
+    }
+}
+
+void NonPreemptivePriorityScheduler::enqueue(Process* p) {
+    readyQueue.push(p);
+}
+
+Process* NonPreemptivePriorityScheduler::selectNext() {
+    if (readyQueue.empty()) return nullptr;
+    
+    Process* next = readyQueue.top();
+    readyQueue.pop();
+    return next;
+}
+
+bool NonPreemptivePriorityScheduler::hasReady() const {
+    return !readyQueue.empty();
+}
+
+void NonPreemptivePriorityScheduler::traceTick() {
+    deque<Process*> queueCopy;
+    auto tempQueue = readyQueue;
+    while (!tempQueue.empty()) {
+        queueCopy.push_back(tempQueue.top());
+        tempQueue.pop();
+    }
+    visualizeQueue(queueCopy, currentProcess);
+}
+
+void NonPreemptivePriorityScheduler::saveQueues(CheckpointWriter& out) const {
+    out.writeSlots(readyQueue.heap());
+}
+
+void NonPreemptivePriorityScheduler::loadQueues(CheckpointReader& in) {
+    in.readSlots(readyQueue.heap());
+}
+
+void NonPreemptivePriorityScheduler::collectReady(vector<Process*>& out) const {
+    auto tempQueue = readyQueue;
+    while (!tempQueue.empty()) {
+        out.push_back(tempQueue.top());
+        tempQueue.pop();
+    }
+}
+
+void NonPreemptivePriorityScheduler::removeReady(Process* p) {
+    removeFromHeap(readyQueue, p);
+}
+
+void NonPreemptivePriorityScheduler::countReady(SchedulerSnapshot& out) const {
+    out.levels = 1;
+    out.levelNames[0] = "ready";
+    out.levelLengths[0] = readyQueue.size();
+}
+
+// ============== Shortest Job First Implementation ==============
+ShortestJobFirstScheduler::ShortestJobFirstScheduler(int contextSwitch)
+    : Scheduler(contextSwitch) {}
+
+string ShortestJobFirstScheduler::getName() const {
+    if (!predictor) {
+        return "SJF";
+    }
+    return "SJF (" + predictor->describe() + ")";
+}
+
+void ShortestJobFirstScheduler::schedule() {
+    if (traceLevel != TRACE_NONE) {
+        cout << "\n========== Shortest Job First Scheduling ("
+             << (predictor ? "predicted bursts: " + predictor->describe() : string("known bursts"))
+             << ") ==========\n";
+    }
+    
+    run();
+    
+    if (traceLevel != TRACE_NONE) {
+        displayMetrics();
+    }
+}
+
+void ShortestJobFirstScheduler::enqueue(Process* p) {
+    readyHeap.emplace_back(expectedBurst(p), p);
+    push_heap(readyHeap.begin(), readyHeap.end(), ShorterJob());
+}
+
+Process* ShortestJobFirstScheduler::selectNext() {
+    if (readyHeap.empty()) return nullptr;
+    
+    pop_heap(readyHeap.begin(), readyHeap.end(), ShorterJob());
+    Process* next = readyHeap.back().second;
+    readyHeap.pop_back();
+    return next;
+}
+
+bool ShortestJobFirstScheduler::hasReady() const {
+    return !readyHeap.empty();
+}
+
+void ShortestJobFirstScheduler::traceTick() {
+    vector<Process*> ready;
+    collectReady(ready);
+    visualizeQueue(deque<Process*>(ready.begin(), ready.end()), currentProcess);
+}
+
+// Keys are the saved predictions, so only the heap order is written
+void ShortestJobFirstScheduler::saveQueues(CheckpointWriter& out) const {
+    vector<Process*> heap;
+    for (const auto& entry : readyHeap) {
+        heap.push_back(entry.second);
+    }
+    out.writeSlots(heap);
+}
+
+void ShortestJobFirstScheduler::loadQueues(CheckpointReader& in) {
+    vector<Process*> heap;
+    in.readSlots(heap);
+    readyHeap.clear();
+    for (Process* p : heap) {
+        readyHeap.emplace_back(expectedBurst(p), p);
+    }
+    make_heap(readyHeap.begin(), readyHeap.end(), ShorterJob());
+}
+
+void ShortestJobFirstScheduler::collectReady(vector<Process*>& out) const {
+    auto sorted = readyHeap;
+    sort_heap(sorted.begin(), sorted.end(), ShorterJob());
+    for (auto it = sorted.rbegin(); it != sorted.rend(); ++it) {
+        out.push_back(it->second);
+    }
+}
+
+void ShortestJobFirstScheduler::removeReady(Process* p) {
+    readyHeap.erase(find_if(readyHeap.begin(), readyHeap.end(),
+                            [p](const pair<double, Process*>& entry) { return entry.second == p; }));
+    make_heap(readyHeap.begin(), readyHeap.end(), ShorterJob());
+}
+
+void ShortestJobFirstScheduler::countReady(SchedulerSnapshot& out) const {
+    out.levels = 1;
+    out.levelNames[0] = "ready";
+    out.levelLengths[0] = readyHeap.size();
+}
+
+// ============== Multilevel Queue Implementation ==============
+MultilevelQueueScheduler::MultilevelQueueScheduler(int quantum, int contextSwitch)
+    : Scheduler(contextSwitch), timeQuantum(quantum) {}
+
+string MultilevelQueueScheduler::getName() const {
+    return "Multilevel Queue (q=" + to_string(timeQuantum) + ")";
+}
+
+void MultilevelQueueScheduler::schedule() {
+    if (traceLevel != TRACE_NONE) {
+        cout << "\n========== Multilevel Queue Scheduling ==========\n";
+        cout << "System Queue (Priority 0-1) > Interactive Queue (Priority 2-3) > Batch Queue (Priority 4-5)\n";
+    }
+    
+    run();
+    
+    if (traceLevel != TRACE_NONE) {
+        displayMetrics();
+    }
+}
+
+int MultilevelQueueScheduler::bandOf(const Process* p) {
+    return p->priority <= 1 ? 0 : (p->priority <= 3 ? 1 : 2);
+}
+
+void MultilevelQueueScheduler::enqueue(Process* p) {
+    deque<Process*>* queues[] = {&systemQueue, &interactiveQueue, &batchQueue};
+    queues[bandOf(p)]->push_back(p);
+}
+
+Process* MultilevelQueueScheduler::selectNext() {
+    Process* next = nullptr;
+    
+    if (!systemQueue.empty()) {
+        next = systemQueue.front();
+        systemQueue.pop_front();
+    } else if (!interactiveQueue.empty()) {
+        next = interactiveQueue.front();
+        interactiveQueue.pop_front();
+    } else if (!batchQueue.empty()) {
+        next = batchQueue.front();
+        batchQueue.pop_front();
+    }
+    return next;
+}
+
+bool MultilevelQueueScheduler::hasReady() const {
+    return !systemQueue.empty() || !interactiveQueue.empty() || !batchQueue.empty();
+}
+
+// System processes run to completion; the other bands are time-sliced
+bool MultilevelQueueScheduler::quantumExpired() const {
+    return timeSlice >= timeQuantum && bandOf(currentProcess) > 0;
+}
+
+// The running band rotates alone while every higher band is empty
+int MultilevelQueueScheduler::steadyRotation(const deque<Process*>*& cycle) const {
+    if (!systemQueue.empty()) return 0;
+    if (bandOf(currentProcess) == 1) {
+        cycle = &interactiveQueue;
+    } else if (interactiveQueue.empty()) {
+        cycle = &batchQueue;
+    } else {
+        return 0;
+    }
+    return timeQuantum;
+}
+
+void MultilevelQueueScheduler::saveQueues(CheckpointWriter& out) const {
+    out.writeSlots(systemQueue);
+    out.writeSlots(interactiveQueue);
+    out.writeSlots(batchQueue);
+}
+
+void MultilevelQueueScheduler::loadQueues(CheckpointReader& in) {
+    in.readSlots(systemQueue);
+    in.readSlots(interactiveQueue);
+    in.readSlots(batchQueue);
+}
+
+void MultilevelQueueScheduler::collectReady(vector<Process*>& out) const {
+    out.insert(out.end(), systemQueue.begin(), systemQueue.end());
+    out.insert(out.end(), interactiveQueue.begin(), interactiveQueue.end());
+    out.insert(out.end(), batchQueue.begin(), batchQueue.end());
+}
+
+void MultilevelQueueScheduler::removeReady(Process* p) {
+    for (deque<Process*>* queue : {&systemQueue, &interactiveQueue, &batchQueue}) {
+        auto it = find(queue->begin(), queue->end(), p);
+        if (it != queue->end()) {
+            queue->erase(it);
+            return;
+        }
+    }
+}
+
+void MultilevelQueueScheduler::countReady(SchedulerSnapshot& out) const {
+    out.levels = 3;
+    out.levelNames[0] = "system";
+    out.levelNames[1] = "interactive";
+    out.levelNames[2] = "batch";
+    out.levelLengths[0] = systemQueue.size();
+    out.levelLengths[1] = interactiveQueue.size();
+    out.levelLengths[2] = batchQueue.size();
+}
+
+int MultilevelQueueScheduler::levelOf(const Process* p) const {
+    return bandOf(p);
+}
+
+void MultilevelQueueScheduler::traceTick() {
+    cout << "\n[Time " << currentTime << "]";
+    cout << " CPU: ";
+    if (currentProcess) {
+        cout << "P" << currentProcess->pid << "(rem:" << currentProcess->remainingTime << ")";
+    } else {
+        cout << "IDLE";
+    }
+    
+    cout << "\n  System Q: [";
+    for (size_t i = 0; i < systemQueue.size(); i++) {
+        cout << "P" << systemQueue[i]->pid << "(rem:" << systemQueue[i]->remainingTime << ")";
+        if (i < systemQueue.size() - 1) cout << ", ";
+    }
+    cout << "]";
+    
+    cout << " | Interactive Q: [";
+    for (size_t i = 0; i < interactiveQueue.size(); i++) {
+        cout << "P" << interactiveQueue[i]->pid << "(rem:" << interactiveQueue[i]->remainingTime << ")";
+        if (i < interactiveQueue.size() - 1) cout << ", ";
+    }
+    cout << "]";
+    
+    cout << " | Batch Q: [";
+    for (size_t i = 0; i < batchQueue.size(); i++) {
+        cout << "P" << batchQueue[i]->pid << "(rem:" << batchQueue[i]->remainingTime << ")";
+        if (i < batchQueue.size() - 1) cout << ", ";
+    }
+    cout << "]\n";
+}
+
+// ============== Multilevel Feedback Queue Implementation ==============
+MultilevelFeedbackQueueScheduler::MultilevelFeedbackQueueScheduler(int contextSwitch, int firstQuantum,
+                                                                   int secondQuantum)
+    : Scheduler(contextSwitch), quantum0(firstQuantum), quantum1(secondQuantum),
+      currentQueueLevel(-1) {}
+
+string MultilevelFeedbackQueueScheduler::getName() const {
+    string name = "MLFQ";
+    if (quantum0 != 8 || quantum1 != 16) {
+        name += " (q=" + to_string(quantum0) + "/" + to_string(quantum1) + ")";
+    }
+    if (predictor) {
+        name += " [" + predictor->describe() + " placement]";
+    }
+    return name;
+}
+
+void MultilevelFeedbackQueueScheduler::schedule() {
+    if (traceLevel != TRACE_NONE) {
+        cout << "\n========== Multilevel Feedback Queue Scheduling ==========\n";
+        cout << "Q0 (quantum=" << quantum0 << ") > Q1 (quantum=" << quantum1 << ") > Q2 (FCFS)\n";
+    }
+    
+    run();
+    
+    if (traceLevel != TRACE_NONE) {
+        displayMetrics();
+    }
+}
+
+void MultilevelFeedbackQueueScheduler::enqueue(Process* p) {
+    queue0.push_back(p);
+    processQueue[p] = 0;
+}
+
+// Place a new process where its predicted burst would end up anyway
+void MultilevelFeedbackQueueScheduler::onArrival(Process* p) {
+    if (!predictor) {
+        enqueue(p);
+        return;
+    }
+    double burst = expectedBurst(p);
+    if (burst <= quantum0) {
+        queue0.push_back(p);
+        processQueue[p] = 0;
+    } else if (burst <= quantum0 + quantum1) {
+        queue1.push_back(p);
+        processQueue[p] = 1;
+    } else {
+        queue2.push_back(p);
+        processQueue[p] = 2;
+    }
+}
+
+Process* MultilevelFeedbackQueueScheduler::selectNext() {
+    Process* next = nullptr;
+    
+    if (!queue0.empty()) {
+        next = queue0.front();
+        queue0.pop_front();
+        currentQueueLevel = 0;
+    } else if (!queue1.empty()) {
+        next = queue1.front();
+        queue1.pop_front();
+        currentQueueLevel = 1;
+    } else if (!queue2.empty()) {
+        next = queue2.front();
+        queue2.pop_front();
+        currentQueueLevel = 2;
+    }
+    return next;
+}
+
+bool MultilevelFeedbackQueueScheduler::hasReady() const {
+    return !queue0.empty() || !queue1.empty() || !queue2.empty();
+}
+
+bool MultilevelFeedbackQueueScheduler::quantumExpired() const {
+    return (currentQueueLevel == 0 && timeSlice >= quantum0) ||
+           (currentQueueLevel == 1 && timeSlice >= quantum1);
+}
+
+// Demote a process that used its whole quantum to the next lower queue
+void MultilevelFeedbackQueueScheduler::onQuantumExpired(Process* p) {
+    if (currentQueueLevel == 0) {
+        processQueue[p] = 1;
+        queue1.push_back(p);
+    } else {
+        processQueue[p] = 2;
+        queue2.push_back(p);
+    }
+    currentQueueLevel = -1;
+}
+
+void MultilevelFeedbackQueueScheduler::onRetire(Process* p) {
+    processQueue.erase(p);
+    currentQueueLevel = -1;
+}
+
+void MultilevelFeedbackQueueScheduler::saveQueues(CheckpointWriter& out) const {
+    out.writeSlots(queue0);
+    out.writeSlots(queue1);
+    out.writeSlots(queue2);
+    out.writeI32(currentQueueLevel);
+    out.writeU64(processQueue.size());
+    for (const auto& entry : processQueue) {
+        out.writeSlot(entry.first);
+        out.writeI32(entry.second);
+    }
+}
+
+void MultilevelFeedbackQueueScheduler::loadQueues(CheckpointReader& in) {
+    in.readSlots(queue0);
+    in.readSlots(queue1);
+    in.readSlots(queue2);
+    currentQueueLevel = in.readI32();
+    processQueue.clear();
+    uint64_t count = in.readU64();
+    for (uint64_t i = 0; i < count; i++) {
+        Process* slot = in.readSlot();
+        if (slot == nullptr) {
+            throw runtime_error("checkpoint is corrupt");
+        }
+        processQueue[slot] = in.readI32();
+    }
+}
+
+void MultilevelFeedbackQueueScheduler::collectReady(vector<Process*>& out) const {
+    out.insert(out.end(), queue0.begin(), queue0.end());
+    out.insert(out.end(), queue1.begin(), queue1.end());
+    out.insert(out.end(), queue2.begin(), queue2.end());
+}
+
+void MultilevelFeedbackQueueScheduler::removeReady(Process* p) {
+    for (deque<Process*>* queue : {&queue0, &queue1, &queue2}) {
+        auto it = find(queue->begin(), queue->end(), p);
+        if (it != queue->end()) {
+            queue->erase(it);
+            break;
+        }
+    }
+    processQueue.erase(p);
+}
+
+void MultilevelFeedbackQueueScheduler::countReady(SchedulerSnapshot& out) const {
+    out.levels = 3;
+    out.levelNames[0] = "Q0";
+    out.levelNames[1] = "Q1";
+    out.levelNames[2] = "Q2";
+    out.levelLengths[0] = queue0.size();
+    out.levelLengths[1] = queue1.size();
+    out.levelLengths[2] = queue2.size();
+}
+
+int MultilevelFeedbackQueueScheduler::levelOf(const Process* p) const {
+    auto level = processQueue.find(p);
+    return level != processQueue.end() ? level->second : 0;
+}
+
+void MultilevelFeedbackQueueScheduler::traceTick() {
+    cout << "\n[Time " << currentTime << "]";
+    cout << " CPU: ";
+    if (currentProcess) {
+        cout << "P" << currentProcess->pid << "(rem:" << currentProcess->remainingTime << ", Q" << currentQueueLevel << ")";
+    } else {
+        cout << "IDLE";
+    }
+    
+    cout << "\n  Q0: [";
+    for (size_t i = 0; i < queue0.size(); i++) {
+        cout << "P" << queue0[i]->pid << "(rem:" << queue0[i]->remainingTime << ")";
+        if (i < queue0.size() - 1) cout << ", ";
+    }
+    cout << "]";
+    
+    cout << " | Q1: [";
+    for (size_t i = 0; i < queue1.size(); i++) {
+        cout << "P" << queue1[i]->pid << "(rem:" << queue1[i]->remainingTime << ")";
+        if (i < queue1.size() - 1) cout << ", ";
+    }
+    cout << "]";
+    
+    cout << " | Q2: [";
+    for (size_t i = 0; i < queue2.size(); i++) {
+        cout << "P" << queue2[i]->pid << "(rem:" << queue2[i]->remainingTime << ")";
+        if (i < queue2.size() - 1) cout << ", ";
+    }
+    cout << "]\n";
+}
@@ -0,0 +1,116 @@
+// src/submission_channel.cpp
+// Lock-free multi-producer submission channel into a running simulation
+
+#include "submission_channel.h"
+#include <thread>
+
+using namespace std;
+
+SubmissionChannel::Lane::Lane(size_t capacity)
+    : mask(0), head(0), cachedTail(0), tail(0), cachedHead(0), closed(false) {
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+    slots.reset(new Submission[size]);
+    mask = size - 1;
+}
+
+SubmissionChannel::SubmissionChannel(size_t producers, size_t capacityPerProducer) {
+    for (size_t i = 0; i < producers; i++) {
+        lanes.push_back(make_unique<Lane>(capacityPerProducer));
+    }
+}
+
+size_t SubmissionChannel::producerCount() const {
+    return lanes.size();
+}
+
+bool SubmissionChannel::tryPush(size_t producer, const Process& p) {
+    Lane& lane = *lanes[producer];
+    size_t t = lane.tail.load(memory_order_relaxed);
+    
+    if (t - lane.cachedHead > lane.mask) {
+        lane.cachedHead = lane.head.load(memory_order_acquire);
+        if (t - lane.cachedHead > lane.mask) {
+            return false;
+        }
+    }
+    
+    lane.slots[t & lane.mask] = Submission{p.pid, p.arrivalTime, p.burstTime, p.priority};
+    lane.tail.store(t + 1, memory_order_release);
+    return true;
+}
+
+void SubmissionChannel::push(size_t producer, const Process& p) {
+    while (!tryPush(producer, p)) {
+        this_thread::yield();
+    }
+}
+
+void SubmissionChannel::close(size_t producer) {
+    lanes[producer]->closed.store(true, memory_order_release);
+}
+
+const Submission* SubmissionChannel::peek(Lane& lane) {
+    size_t h = lane.head.load(memory_order_relaxed);
+    
+    if (h == lane.cachedTail) {
+        lane.cachedTail = lane.tail.load(memory_order_acquire);
+        if (h == lane.cachedTail) {
+            return nullptr;
+        }
+    }
+    return &lane.slots[h & lane.mask];
+}
+
+bool SubmissionChannel::tryPop(Process& out) {
+    Lane* best = nullptr;
+    const Submission* bestFront = nullptr;
+    
+    for (auto& lanePtr : lanes) {
+        Lane& lane = *lanePtr;
+        const Submission* front = peek(lane);
+        
+        if (front == nullptr) {
+            // An open, empty lane may still produce an earlier arrival
+            if (!lane.closed.load(memory_order_acquire)) {
+                return false;
+            }
+            // Items pushed before close() are visible after the acquire
+            front = peek(lane);
+            if (front == nullptr) continue;
+        }
+        
+        if (bestFront == nullptr || front->arrivalTime < bestFront->arrivalTime) {
+            best = &lane;
+            bestFront = front;
+        }
+    }
+    
+    if (best == nullptr) return false;
+    
+    out = Process(bestFront->pid, bestFront->arrivalTime, bestFront->burstTime, bestFront->priority);
+    best->head.store(best->head.load(memory_order_relaxed) + 1, memory_order_release);
+    return true;
+}
+
+bool SubmissionChannel::finished() {
+    for (auto& lanePtr : lanes) {
+        Lane& lane = *lanePtr;
+        if (!lane.closed.load(memory_order_acquire) || peek(lane) != nullptr) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t SubmissionChannel::feed(Scheduler& scheduler) {
+    size_t count = 0;
+    Process p(0, 0, 0);
+    
+    while (tryPop(p)) {
+        scheduler.advanceUntil(p.arrivalTime);
+        scheduler.submit(p);
+        count++;
+    }
+    return count;
+}
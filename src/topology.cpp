@@ -0,0 +1,410 @@
+// src/topology.cpp
+// Multi-CPU simulation with placement, balancing and a cache/NUMA cost model
+
+#include "topology.h"
+#include <algorithm>
+#include <deque>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+
+using namespace std;
+
+// ============== CpuTopology Implementation ==============
+CpuTopology::CpuTopology(int sockets, int cores, int threads)
+    : sockets(sockets), coresPerSocket(cores), threadsPerCore(threads) {}
+
+CpuTopology CpuTopology::parse(const string& spec) {
+    vector<int> sizes;
+    stringstream ss(spec);
+    string item;
+    while (getline(ss, item, 'x')) {
+        try {
+            size_t used = 0;
+            int value = stoi(item, &used);
+            if (used != item.size() || value < 1) break;
+            sizes.push_back(value);
+        } catch (const exception&) {
+            break;
+        }
+    }
+    if (sizes.size() != 3 || spec.back() == 'x') {
+        throw invalid_argument("invalid topology '" + spec + "' (expected SOCKETSxCORESxTHREADS)");
+    }
+    return CpuTopology(sizes[0], sizes[1], sizes[2]);
+}
+
+int CpuTopology::cpuCount() const {
+    return sockets * coresPerSocket * threadsPerCore;
+}
+
+int CpuTopology::coreOf(int cpu) const {
+    return cpu / threadsPerCore;
+}
+
+int CpuTopology::socketOf(int cpu) const {
+    return cpu / (coresPerSocket * threadsPerCore);
+}
+
+CpuDistance CpuTopology::distance(int from, int to) const {
+    if (from == to) return SAME_CPU;
+    if (coreOf(from) == coreOf(to)) return SMT_SIBLING;
+    if (socketOf(from) == socketOf(to)) return SAME_SOCKET;
+    return REMOTE_SOCKET;
+}
+
+string CpuTopology::describe() const {
+    return to_string(sockets) + " socket(s) x " + to_string(coresPerSocket) + " core(s) x " +
+           to_string(threadsPerCore) + " thread(s) = " + to_string(cpuCount()) + " CPUs";
+}
+
+CacheCosts::CacheCosts()
+    : coreMiss(1), llcMiss(3), remoteMemory(2), coreCacheProcesses(2), socketCacheProcesses(16) {}
+
+TopologyOptions::TopologyOptions()
+    : placement(PLACE_SMT_AWARE), balanceInterval(16), remoteImbalance(4) {}
+
+TopologyCounters::TopologyCounters()
+    : dispatches(0), smtMigrations(0), coreMigrations(0), socketMigrations(0),
+      coreMisses(0), llcMisses(0), remoteDispatches(0), penaltyTime(0) {}
+
+uint64_t TopologyCounters::migrations() const {
+    return smtMigrations + coreMigrations + socketMigrations;
+}
+
+uint64_t TopologyCounters::cacheMisses() const {
+    return coreMisses + llcMisses;
+}
+
+// ============== Cache Warmth ==============
+// Where each live process last ran, and the most recently dispatched
+// processes per core and per socket (front = most recent). The lists are
+// a few entries long, so a linear scan is cheaper than any index.
+struct ProcessHome {
+    int lastCpu;
+    int socket;
+};
+
+struct TopologySimulator::CacheState {
+    vector<deque<int>> coreRecent;
+    vector<deque<int>> socketRecent;
+    unordered_map<int, ProcessHome> homes;
+    TopologyCounters counters;
+};
+
+// Marks pid as the most recent user of a cache; returns whether it was warm
+static bool touch(deque<int>& recent, int pid, int capacity) {
+    auto it = find(recent.begin(), recent.end(), pid);
+    bool warm = it != recent.end();
+    if (warm) {
+        recent.erase(it);
+    }
+    if (capacity > 0) {
+        recent.push_front(pid);
+        if ((int)recent.size() > capacity) {
+            recent.pop_back();
+        }
+    }
+    return warm;
+}
+
+static void forget(deque<int>& recent, int pid) {
+    auto it = find(recent.begin(), recent.end(), pid);
+    if (it != recent.end()) {
+        recent.erase(it);
+    }
+}
+
+// ============== TopologyCostModel Implementation ==============
+// Prices dispatches on one logical CPU against the shared warmth state
+class TopologyCostModel : public DispatchCostModel {
+private:
+    const TopologyOptions& options;
+    TopologySimulator::CacheState& state;
+    int cpu;
+    
+public:
+    TopologyCostModel(const TopologyOptions& options, TopologySimulator::CacheState& state, int cpu)
+        : options(options), state(state), cpu(cpu) {}
+    
+    int dispatchPenalty(const Process& next) override {
+        const CpuTopology& topology = options.topology;
+        const CacheCosts& costs = options.costs;
+        TopologyCounters& counters = state.counters;
+        int socket = topology.socketOf(cpu);
+        counters.dispatches++;
+        
+        bool coreWarm = touch(state.coreRecent[topology.coreOf(cpu)], next.pid, costs.coreCacheProcesses);
+        bool socketWarm = touch(state.socketRecent[socket], next.pid, costs.socketCacheProcesses);
+        
+        // A first dispatch pays no penalty: its memory is allocated here
+        auto it = state.homes.find(next.pid);
+        if (it == state.homes.end()) {
+            state.homes.emplace(next.pid, ProcessHome{cpu, socket});
+            return 0;
+        }
+        
+        ProcessHome& home = it->second;
+        switch (topology.distance(home.lastCpu, cpu)) {
+            case SAME_CPU: break;
+            case SMT_SIBLING: counters.smtMigrations++; break;
+            case SAME_SOCKET: counters.coreMigrations++; break;
+            case REMOTE_SOCKET: counters.socketMigrations++; break;
+        }
+        home.lastCpu = cpu;
+        
+        int penalty = 0;
+        if (!coreWarm) {
+            if (socketWarm) {
+                counters.coreMisses++;
+                penalty += costs.coreMiss;
+            } else {
+                counters.llcMisses++;
+                penalty += costs.llcMiss;
+            }
+        }
+        if (socket != home.socket) {
+            counters.remoteDispatches++;
+            penalty += costs.remoteMemory;
+        }
+        counters.penaltyTime += penalty;
+        return penalty;
+    }
+    
+    void processRetired(const Process& p) override {
+        auto it = state.homes.find(p.pid);
+        if (it == state.homes.end()) return;
+        int last = it->second.lastCpu;
+        forget(state.coreRecent[options.topology.coreOf(last)], p.pid);
+        forget(state.socketRecent[options.topology.socketOf(last)], p.pid);
+        state.homes.erase(it);
+    }
+};
+
+// ============== TopologySimulator Implementation ==============
+TopologySimulator::TopologySimulator(const TopologyOptions& opts, const SchedulerFactory& factory)
+    : options(opts), cache(make_unique<CacheState>()), nextBalance(0), nextAdmission(0) {
+    const CpuTopology& topology = options.topology;
+    if (topology.sockets < 1 || topology.coresPerSocket < 1 || topology.threadsPerCore < 1) {
+        throw invalid_argument("topology needs at least one socket, core and thread");
+    }
+    if (options.balanceInterval < 1) {
+        throw invalid_argument("balance interval must be positive");
+    }
+    
+    cache->coreRecent.resize(topology.sockets * topology.coresPerSocket);
+    cache->socketRecent.resize(topology.sockets);
+    nextBalance = options.balanceInterval;
+    
+    for (int cpu = 0; cpu < topology.cpuCount(); cpu++) {
+        models.push_back(make_unique<TopologyCostModel>(options, *cache, cpu));
+        cpus.push_back(factory());
+        cpus.back()->setTraceLevel(TRACE_NONE);
+        cpus.back()->setRetention(RETAIN_AGGREGATES);
+        cpus.back()->setDispatchCostModel(models.back().get());
+    }
+}
+
+TopologySimulator::~TopologySimulator() {}
+
+// Submitted but not finished, including arrivals not yet admitted
+size_t TopologySimulator::load(int cpu) const {
+    return cpus[cpu]->getProcessCount() - cpus[cpu]->getCompletedCount();
+}
+
+// Lowest (socket load, core load, CPU load) as the policy sees it; ties
+// go to the lowest-numbered CPU
+int TopologySimulator::place() const {
+    const CpuTopology& topology = options.topology;
+    vector<size_t> coreLoad(topology.sockets * topology.coresPerSocket, 0);
+    vector<size_t> socketLoad(topology.sockets, 0);
+    for (int cpu = 0; cpu < (int)cpus.size(); cpu++) {
+        coreLoad[topology.coreOf(cpu)] += load(cpu);
+        socketLoad[topology.socketOf(cpu)] += load(cpu);
+    }
+    
+    auto key = [&](int cpu) {
+        size_t socket = options.placement == PLACE_NUMA_LOCAL ? socketLoad[topology.socketOf(cpu)] : 0;
+        size_t core = options.placement == PLACE_LEAST_LOADED ? 0 : coreLoad[topology.coreOf(cpu)];
+        return make_tuple(socket, core, load(cpu));
+    };
+    int best = 0;
+    for (int cpu = 1; cpu < (int)cpus.size(); cpu++) {
+        if (key(cpu) < key(best)) {
+            best = cpu;
+        }
+    }
+    return best;
+}
+
+// Where the balancer sends work from an overloaded CPU, or -1. The
+// topology-aware policies try the SMT sibling, then the socket, then the
+// other sockets, and take the first that is at least two processes lighter.
+int TopologySimulator::balanceTarget(int from) const {
+    const CpuTopology& topology = options.topology;
+    vector<CpuDistance> reach = {SMT_SIBLING, SAME_SOCKET, REMOTE_SOCKET};
+    
+    for (CpuDistance distance : reach) {
+        int best = -1;
+        for (int cpu = 0; cpu < (int)cpus.size(); cpu++) {
+            bool inReach = options.placement == PLACE_LEAST_LOADED ? cpu != from
+                                                                    : topology.distance(from, cpu) == distance;
+            if (inReach && (best < 0 || load(cpu) < load(best))) {
+                best = cpu;
+            }
+        }
+        size_t gap = 2;
+        if (distance == REMOTE_SOCKET && options.placement == PLACE_NUMA_LOCAL) {
+            gap = max(2, options.remoteImbalance);
+        }
+        if (best >= 0 && load(from) >= load(best) + gap) {
+            return best;
+        }
+        if (options.placement == PLACE_LEAST_LOADED) break;
+    }
+    return -1;
+}
+
+// Moves one waiting process at a time off the busiest CPU until it has no
+// lighter target within reach
+void TopologySimulator::balance() {
+    for (size_t moves = 0; moves < cpus.size(); moves++) {
+        int busiest = 0;
+        for (int cpu = 1; cpu < (int)cpus.size(); cpu++) {
+            if (load(cpu) > load(busiest)) {
+                busiest = cpu;
+            }
+        }
+        int target = balanceTarget(busiest);
+        if (target < 0) break;
+        
+        Process p(0, 0, 0);
+        if (!cpus[busiest]->detachReady(p)) break;
+        cpus[target]->submit(p);
+    }
+}
+
+void TopologySimulator::advanceAll(int time) {
+    while (nextBalance <= time) {
+        bool idle = true;
+        for (int cpu = 0; cpu < (int)cpus.size(); cpu++) {
+            idle = idle && load(cpu) == 0;
+        }
+        if (idle) {
+            // Nothing to balance until the next arrival
+            nextBalance += ((time - nextBalance) / options.balanceInterval + 1) * options.balanceInterval;
+            break;
+        }
+        for (auto& cpu : cpus) {
+            cpu->advanceUntil(nextBalance);
+        }
+        balance();
+        nextBalance += options.balanceInterval;
+    }
+    for (auto& cpu : cpus) {
+        cpu->advanceUntil(time);
+    }
+}
+
+// The cost model keys warmth by pid, and the admission id follows the
+// process through balancing; per-process output is never kept here
+void TopologySimulator::submit(const Process& p) {
+    advanceAll(p.arrivalTime);
+    Process admitted = p;
+    admitted.pid = nextAdmission++;
+    cpus[place()]->submit(admitted);
+}
+
+void TopologySimulator::finish() {
+    while (true) {
+        bool busy = false;
+        for (int cpu = 0; cpu < (int)cpus.size(); cpu++) {
+            busy = busy || load(cpu) > 0;
+        }
+        if (!busy) break;
+        advanceAll(nextBalance);
+    }
+}
+
+string TopologySimulator::getName() const {
+    return cpus[0]->getName();
+}
+
+int TopologySimulator::getCpuCount() const {
+    return (int)cpus.size();
+}
+
+const Scheduler& TopologySimulator::getCpu(int cpu) const {
+    return *cpus.at(cpu);
+}
+
+size_t TopologySimulator::getProcessCount() const {
+    size_t total = 0;
+    for (const auto& cpu : cpus) {
+        total += cpu->getProcessCount();
+    }
+    return total;
+}
+
+size_t TopologySimulator::getCompletedCount() const {
+    size_t total = 0;
+    for (const auto& cpu : cpus) {
+        total += cpu->getCompletedCount();
+    }
+    return total;
+}
+
+int TopologySimulator::getMakespan() const {
+    int makespan = 0;
+    for (const auto& cpu : cpus) {
+        makespan = max(makespan, cpu->getMakespan());
+    }
+    return makespan;
+}
+
+MetricsAggregate TopologySimulator::getAggregate() const {
+    MetricsAggregate merged;
+    for (const auto& cpu : cpus) {
+        merged.merge(cpu->getAggregate());
+    }
+    return merged;
+}
+
+PhaseProfile TopologySimulator::getPhaseProfile() const {
+    PhaseProfile merged;
+    for (const auto& cpu : cpus) {
+        merged.merge(cpu->getPhaseProfile());
+    }
+    return merged;
+}
+
+const TopologyCounters& TopologySimulator::getCounters() const {
+    return cache->counters;
+}
+
+void TopologySimulator::displayMetrics() const {
+    static const char* PLACEMENT_NAMES[] = {"least-loaded", "smt", "numa"};
+    const TopologyCounters& counters = cache->counters;
+    MetricsAggregate merged = getAggregate();
+    
+    cout << "\n========== Topology Metrics ==========\n";
+    cout << fixed << setprecision(2);
+    cout << getName() << " on " << options.topology.describe()
+         << ", placement " << PLACEMENT_NAMES[options.placement] << "\n";
+    cout << "Completed Processes: " << getCompletedCount() << "\n";
+    cout << "Dispatches: " << counters.dispatches << "\n";
+    cout << "Migrations (SMT / core / socket): " << counters.smtMigrations << " / "
+         << counters.coreMigrations << " / " << counters.socketMigrations << "\n";
+    cout << "Cache Misses (core / LLC): " << counters.coreMisses << " / " << counters.llcMisses << "\n";
+    cout << "Remote-Memory Dispatches: " << counters.remoteDispatches << "\n";
+    cout << "Penalty Time: " << counters.penaltyTime << " ms\n";
+    cout << "Average Waiting Time: " << merged.waiting.getMean() << " ms\n";
+    cout << "Average Turnaround Time: " << merged.turnaround.getMean() << " ms\n";
+    cout << "Average Response Time: " << merged.response.getMean() << " ms\n";
+    cout << "======================================\n";
+    
+    if (phaseProfilingEnabled()) {
+        getPhaseProfile().writeReport(cout);
+    }
+}
@@ -0,0 +1,405 @@
+// src/trace_import.cpp
+// Streaming importer for kernel scheduler traces (ftrace, perf sched)
+
+#include "trace_import.h"
+#include <charconv>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+static const uint64_t NO_BURST = UINT64_MAX;
+static const size_t READ_CHUNK = 1 << 20;
+
+TraceImportOptions::TraceImportOptions() : tickMicros(1000), maxHeldBursts(1 << 16) {}
+
+TraceImportStats::TraceImportStats()
+    : lines(0), events(0), bursts(0), truncatedBursts(0), splitBursts(0), ioWaits(0), ioWaitTime(0),
+      migrations(0), cpus(0), makespan(0) {}
+
+// ============== Field Parsing ==============
+// All parsing works on views into the caller's buffer; nothing is copied
+
+static bool parseNumber(string_view text, int& value) {
+    auto result = from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == errc() && result.ptr == text.data() + text.size();
+}
+
+// "1234.567890" (micro- or nanosecond fraction) to microseconds
+static bool parseTimestamp(string_view text, int64_t& micros) {
+    size_t dot = text.find('.');
+    if (dot == string_view::npos || dot == 0) return false;
+    int64_t seconds = 0;
+    auto result = from_chars(text.data(), text.data() + dot, seconds);
+    if (result.ec != errc() || result.ptr != text.data() + dot) return false;
+    
+    int64_t fraction = 0;
+    int digits = 0;
+    for (size_t i = dot + 1; i < text.size(); i++) {
+        if (text[i] < '0' || text[i] > '9') return false;
+        if (digits < 6) {
+            fraction = fraction * 10 + (text[i] - '0');
+            digits++;
+        }
+    }
+    for (; digits < 6; digits++) fraction *= 10;
+    micros = seconds * 1000000 + fraction;
+    return true;
+}
+
+// Value of a key=value field that starts a token: "prev_pid=12 ..." -> "12".
+// Tracepoints print their fields in a fixed order, so text is advanced past
+// the match and the next lookup resumes there.
+static bool nextField(string_view& text, string_view key, string_view& value) {
+    size_t pos = 0;
+    while ((pos = text.find(key, pos)) != string_view::npos) {
+        if (pos == 0 || text[pos - 1] == ' ') {
+            size_t start = pos + key.size();
+            size_t stop = min(text.find(' ', start), text.size());
+            value = text.substr(start, stop - start);
+            text.remove_prefix(stop);
+            return true;
+        }
+        pos += key.size();
+    }
+    return false;
+}
+
+// Compact task form "comm:pid [prio]"; comm may itself contain ':' or spaces
+static bool parseCompactTask(string_view text, int& pid, int& prio) {
+    size_t open = text.rfind(" [");
+    if (open == string_view::npos) return false;
+    size_t close = text.find(']', open);
+    size_t colon = text.rfind(':', open);
+    if (close == string_view::npos || colon == string_view::npos) return false;
+    return parseNumber(text.substr(colon + 1, open - colon - 1), pid) &&
+           parseNumber(text.substr(open + 2, close - open - 2), prio);
+}
+
+// Kernel priorities (0-99 real-time, 100-139 nice -20..19) onto the 0-5
+// scale the policies use, lower first
+static int mapPriority(int prio) {
+    if (prio < 100) return 0;
+    if (prio < 110) return 1;
+    if (prio < 120) return 2;
+    if (prio == 120) return 3;
+    if (prio < 130) return 4;
+    return 5;
+}
+
+// ============== TraceImporter Implementation ==============
+TraceImporter::TraceImporter(const TraceImportOptions& opts, Sink output)
+    : options(opts), sink(move(output)), firstSequence(0), origin(-1), lastTimestamp(0), nextPid(1) {
+    if (options.tickMicros < 1) {
+        throw invalid_argument("trace tick must be at least one microsecond");
+    }
+}
+
+void TraceImporter::feed(const char* data, size_t size) {
+    const char* p = data;
+    const char* end = data + size;
+    
+    // Complete the line split across the previous chunk
+    if (!carry.empty()) {
+        const char* newline = static_cast<const char*>(memchr(p, '\n', size));
+        if (newline == nullptr) {
+            carry.append(p, size);
+            return;
+        }
+        carry.append(p, newline - p);
+        parseLine(carry.data(), carry.data() + carry.size());
+        carry.clear();
+        p = newline + 1;
+    }
+    
+    while (p < end) {
+        const char* newline = static_cast<const char*>(memchr(p, '\n', end - p));
+        if (newline == nullptr) {
+            carry.assign(p, end);
+            break;
+        }
+        parseLine(p, newline);
+        p = newline + 1;
+    }
+}
+
+// Layout: "<comm>-<pid> [cpu] <flags> <secs.usecs>: <event>: <fields>",
+// where perf script prefixes the event with "sched:"
+void TraceImporter::parseLine(const char* begin, const char* end) {
+    stats.lines++;
+    string_view line(begin, end - begin);
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    
+    bool isSwitch = false;
+    size_t event = 0;
+    string_view fields;
+    while ((event = line.find("sched_", event)) != string_view::npos) {
+        string_view rest = line.substr(event + 6);
+        if (rest.substr(0, 8) == "switch: ") {
+            isSwitch = true;
+            fields = rest.substr(8);
+            break;
+        }
+        if (rest.substr(0, 8) == "wakeup: " || rest.substr(0, 12) == "wakeup_new: ") {
+            fields = rest.substr(rest[6] == ':' ? 8 : 12);
+            break;
+        }
+        event += 6;
+    }
+    if (event == string_view::npos) return;
+    
+    // Timestamp token ends with ':' just before the event name
+    size_t stop = event;
+    if (stop >= 6 && line.substr(stop - 6, 6) == "sched:") stop -= 6;
+    while (stop > 0 && line[stop - 1] == ' ') stop--;
+    if (stop == 0 || line[stop - 1] != ':') return;
+    size_t start = line.rfind(' ', stop - 1);
+    start = start == string_view::npos ? 0 : start + 1;
+    int64_t time;
+    if (!parseTimestamp(line.substr(start, stop - 1 - start), time)) return;
+    
+    // CPU is the last bracketed number before the timestamp
+    int cpu = 0;
+    size_t close = line.rfind(']', start);
+    size_t open = close == string_view::npos ? string_view::npos : line.rfind('[', close);
+    if (open == string_view::npos || !parseNumber(line.substr(open + 1, close - open - 1), cpu)) return;
+    
+    if (origin < 0) origin = time;
+    lastTimestamp = max(lastTimestamp, time);
+    stats.cpus = max(stats.cpus, cpu + 1);
+    
+    if (!isSwitch) {
+        int pid, prio = 120;
+        string_view value;
+        string_view rest = fields;
+        if (nextField(rest, "pid=", value)) {
+            if (!parseNumber(value, pid)) return;
+            if (nextField(rest, "prio=", value) && !parseNumber(value, prio)) return;
+        } else if (!parseCompactTask(fields.substr(0, fields.find(']') + 1), pid, prio)) {
+            return;
+        }
+        stats.events++;
+        onWakeup(time, pid, prio);
+        return;
+    }
+    
+    int prevPid, nextPid, prevPrio, nextPrio = 120;
+    char prevState;
+    string_view value, rest = fields;
+    if (nextField(rest, "prev_pid=", value)) {
+        string_view state, next, prio;
+        if (!parseNumber(value, prevPid) || !nextField(rest, "prev_state=", state) || state.empty() ||
+            !nextField(rest, "next_pid=", next) || !parseNumber(next, nextPid)) {
+            return;
+        }
+        if (nextField(rest, "next_prio=", prio) && !parseNumber(prio, nextPrio)) return;
+        prevState = state[0];
+    } else {
+        size_t arrow = fields.find(" ==> ");
+        if (arrow == string_view::npos) return;
+        string_view left = fields.substr(0, arrow);
+        size_t bracket = left.rfind(']');
+        if (bracket == string_view::npos || !parseCompactTask(left.substr(0, bracket + 1), prevPid, prevPrio)) {
+            return;
+        }
+        size_t state = left.find_first_not_of(' ', bracket + 1);
+        if (state == string_view::npos || !parseCompactTask(fields.substr(arrow + 5), nextPid, nextPrio)) {
+            return;
+        }
+        prevState = left[state];
+    }
+    stats.events++;
+    onSwitch(time, cpu, prevPid, prevState, nextPid, nextPrio);
+}
+
+TraceImporter::Burst* TraceImporter::openBurst(Task& task, int pid, int64_t time, int prio) {
+    task.burst = firstSequence + open.size();
+    open.push_back(Burst{time, -1, -1, 0, 0, pid, prio, false});
+    return &open.back();
+}
+
+void TraceImporter::onWakeup(int64_t time, int pid, int prio) {
+    if (pid == 0) return;
+    Task& task = tasks.try_emplace(pid, Task{NO_BURST, -1, -1, false}).first->second;
+    if (task.burst != NO_BURST) return;     // already runnable
+    
+    if (task.blockedAt >= 0 && task.ioWait) {
+        stats.ioWaits++;
+        stats.ioWaitTime += ticks(time - task.blockedAt);
+    }
+    task.blockedAt = -1;
+    openBurst(task, pid, time, prio);
+}
+
+// Runnable states (R, R+) keep the burst open; any sleep or exit ends it
+void TraceImporter::onSwitch(int64_t time, int cpu, int prevPid, char prevState, int nextPid, int nextPrio) {
+    if (prevPid != 0) {
+        Task& task = tasks.try_emplace(prevPid, Task{NO_BURST, -1, -1, false}).first->second;
+        if (task.burst != NO_BURST) {
+            Burst& burst = open[task.burst - firstSequence];
+            if (burst.runStart >= 0) {
+                burst.cpuTime += time - burst.runStart;
+                burst.runStart = -1;
+            }
+            if (prevState != 'R') {
+                burst.done = true;
+                burst.end = time;
+                task.burst = NO_BURST;
+            }
+        }
+        if (prevState != 'R') {
+            task.blockedAt = time;
+            task.ioWait = prevState == 'D';
+            if (prevState == 'X' || prevState == 'Z') {
+                tasks.erase(prevPid);
+            }
+        }
+    }
+    
+    if (nextPid != 0) {
+        Task& task = tasks.try_emplace(nextPid, Task{NO_BURST, -1, -1, false}).first->second;
+        // Running without a recorded wakeup: the wakeup predates the trace
+        Burst* burst = task.burst == NO_BURST ? openBurst(task, nextPid, time, nextPrio)
+                                              : &open[task.burst - firstSequence];
+        burst->runStart = time;
+        if (burst->firstRun < 0) burst->firstRun = time;
+        if (task.lastCpu >= 0 && task.lastCpu != cpu) stats.migrations++;
+        task.lastCpu = cpu;
+        task.blockedAt = -1;
+    }
+    flush();
+}
+
+int64_t TraceImporter::ticks(int64_t micros) const {
+    return (micros + options.tickMicros / 2) / options.tickMicros;
+}
+
+// Simulated times are ints; a trace too long for the tick is an error
+static int checkedTicks(int64_t ticks) {
+    if (ticks > INT_MAX) {
+        throw runtime_error("trace spans more than " + to_string(INT_MAX) +
+                            " simulated time units; use a larger --sched-tick");
+    }
+    return (int)ticks;
+}
+
+// Ends the oldest open burst now; its task stays runnable and carries on
+// in a new burst that arrives at this time
+void TraceImporter::splitFront() {
+    Burst& burst = open.front();
+    bool running = burst.runStart >= 0;
+    if (running) {
+        burst.cpuTime += lastTimestamp - burst.runStart;
+        burst.runStart = -1;
+    }
+    burst.done = true;
+    burst.end = lastTimestamp;
+    stats.splitBursts++;
+    
+    Burst* rest = openBurst(tasks.at(burst.pid), burst.pid, lastTimestamp, burst.priority);
+    if (running) {
+        rest->runStart = lastTimestamp;
+        rest->firstRun = lastTimestamp;
+    }
+}
+
+// Hands out completed bursts in arrival order
+void TraceImporter::flush() {
+    while (!open.empty()) {
+        if (!open.front().done) {
+            if (open.size() <= options.maxHeldBursts || open.front().arrival >= lastTimestamp) break;
+            splitFront();
+        }
+        const Burst& b = open.front();
+        int64_t cpuTicks = (b.cpuTime + options.tickMicros - 1) / options.tickMicros;
+        Process p(nextPid++, checkedTicks(ticks(max<int64_t>(b.arrival - origin, 0))),
+                  checkedTicks(max<int64_t>(cpuTicks, 1)), mapPriority(b.priority));
+        
+        Process kernel = p;
+        kernel.turnaroundTime = checkedTicks(ticks(b.end - b.arrival));
+        kernel.waitingTime = checkedTicks(ticks(b.end - b.arrival - b.cpuTime));
+        kernel.responseTime = checkedTicks(ticks((b.firstRun < 0 ? b.end : b.firstRun) - b.arrival));
+        stats.kernel.add(kernel);
+        stats.makespan = max(stats.makespan, checkedTicks(ticks(b.end - origin)));
+        stats.bursts++;
+        
+        open.pop_front();
+        firstSequence++;
+        sink(p);
+    }
+}
+
+void TraceImporter::finish() {
+    if (!carry.empty()) {
+        parseLine(carry.data(), carry.data() + carry.size());
+        carry.clear();
+    }
+    for (Burst& burst : open) {
+        if (burst.done) continue;
+        if (burst.runStart >= 0) {
+            burst.cpuTime += lastTimestamp - burst.runStart;
+        }
+        burst.done = true;
+        burst.end = lastTimestamp;
+        stats.truncatedBursts++;
+    }
+    tasks.clear();
+    flush();
+}
+
+const TraceImportStats& TraceImporter::getStats() const {
+    return stats;
+}
+
+// ============== File Import ==============
+TraceImportStats importTrace(const string& path, const TraceImportOptions& options,
+                             const TraceImporter::Sink& sink) {
+    TraceImporter importer(options, sink);
+    
+    if (path == "-") {
+        vector<char> buffer(READ_CHUNK);
+        while (cin.read(buffer.data(), buffer.size()) || cin.gcount() > 0) {
+            importer.feed(buffer.data(), cin.gcount());
+        }
+        importer.finish();
+        return importer.getStats();
+    }
+    
+    // Closed (and unmapped) on every exit, including a throwing sink
+    struct MappedFile {
+        int fd = -1;
+        void* data = MAP_FAILED;
+        size_t size = 0;
+        ~MappedFile() {
+            if (data != MAP_FAILED) munmap(data, size);
+            if (fd >= 0) close(fd);
+        }
+    } file;
+    
+    file.fd = open(path.c_str(), O_RDONLY);
+    struct stat info;
+    if (file.fd < 0 || fstat(file.fd, &info) != 0) {
+        throw runtime_error("cannot open trace file '" + path + "'");
+    }
+    
+    // The mapping is parsed in place; lines are never copied
+    file.size = info.st_size;
+    if (file.size > 0) {
+        file.data = mmap(nullptr, file.size, PROT_READ, MAP_PRIVATE, file.fd, 0);
+        if (file.data == MAP_FAILED) {
+            throw runtime_error("cannot map trace file '" + path + "'");
+        }
+        madvise(file.data, file.size, MADV_SEQUENTIAL);
+        importer.feed(static_cast<const char*>(file.data), file.size);
+    }
+    importer.finish();
+    return importer.getStats();
+}
@@ -0,0 +1,125 @@
+// src/what_if.cpp
+// Forks one simulation prefix into several scheduler configurations
+
+#include "what_if.h"
+#include <chrono>
+#include <optional>
+#include <sstream>
+#include <thread>
+
+using namespace std;
+
+struct Branch {
+    unique_ptr<Scheduler> scheduler;
+    int quantum;
+    double wallTimeMs;
+};
+
+// Finishes one run after the branch point: the rest of the synthetic stream
+// (if any) is replayed from this thread's own copy of the generator
+static void finish(Branch& branch, optional<WorkloadGenerator> feed, optional<Process> lookahead) {
+    Scheduler& scheduler = *branch.scheduler;
+    auto start = chrono::steady_clock::now();
+    
+    if (lookahead) {
+        scheduler.advanceUntil(lookahead->arrivalTime);
+        scheduler.submit(*lookahead);
+    }
+    while (feed && feed->hasNext()) {
+        Process p = feed->next();
+        scheduler.advanceUntil(p.arrivalTime);
+        scheduler.submit(p);
+    }
+    while (scheduler.step()) {}
+    
+    auto end = chrono::steady_clock::now();
+    branch.wallTimeMs = chrono::duration<double, milli>(end - start).count();
+}
+
+vector<RunResult> runWhatIf(const BatchOptions& options, const vector<Process>& workload) {
+    vector<Branch> runs;
+    for (const auto& algorithm : options.algorithms) {
+        vector<int> quanta = options.quanta;
+        if (!algorithmUsesQuantum(algorithm)) {
+            quanta = {0};
+        }
+        for (int quantum : quanta) {
+            Branch branch{makeScheduler(algorithm, quantum, options.contextSwitch, options.predictor),
+                          quantum, 0.0};
+            branch.scheduler->setTraceLevel(TRACE_NONE);
+            runs.push_back(move(branch));
+        }
+    }
+    
+    // Replay the shared prefix once on the baseline
+    Scheduler& baseline = *runs[0].scheduler;
+    baseline.setRetention(RETAIN_AGGREGATES);
+    optional<WorkloadGenerator> feed;
+    optional<Process> lookahead;
+    if (options.generate) {
+        feed.emplace(options.generator);
+        while (feed->hasNext()) {
+            Process p = feed->next();
+            if (p.arrivalTime > options.branchTime) {
+                lookahead = p;
+                break;
+            }
+            baseline.advanceUntil(p.arrivalTime);
+            baseline.submit(p);
+        }
+    } else {
+        for (const auto& p : workload) {
+            baseline.addProcess(p);
+        }
+    }
+    baseline.advanceUntil(options.branchTime);
+    
+    for (size_t i = 1; i < runs.size(); i++) {
+        runs[i].scheduler->branchFrom(baseline);
+    }
+    
+    vector<thread> threads;
+    for (auto& run : runs) {
+        threads.emplace_back(finish, ref(run), feed, lookahead);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    
+    vector<RunResult> results;
+    for (const auto& run : runs) {
+        results.push_back(summarizeRun(*run.scheduler, run.quantum, run.wallTimeMs));
+    }
+    return results;
+}
+
+static string signedPercent(double value, double base) {
+    if (base == 0.0) return "n/a";
+    ostringstream out;
+    out << showpos << fixed << setprecision(1) << (value - base) * 100.0 / base << "%";
+    return out.str();
+}
+
+void writeComparison(ostream& out, const vector<RunResult>& results) {
+    if (results.empty()) return;
+    const RunResult& base = results[0];
+    
+    out << "\n========== What-If vs Baseline: " << base.algorithm << " ==========\n";
+    out << left << setw(28) << "Branch"
+        << right << setw(12) << "Avg Wait"
+        << setw(12) << "Avg Turn"
+        << setw(12) << "Avg Resp"
+        << setw(12) << "p95 Turn"
+        << setw(11) << "Makespan" << "\n";
+    out << string(87, '-') << "\n";
+    for (size_t i = 1; i < results.size(); i++) {
+        const RunResult& r = results[i];
+        out << left << setw(28) << r.algorithm
+            << right << setw(12) << signedPercent(r.avgWaiting, base.avgWaiting)
+            << setw(12) << signedPercent(r.avgTurnaround, base.avgTurnaround)
+            << setw(12) << signedPercent(r.avgResponse, base.avgResponse)
+            << setw(12) << signedPercent(r.p95Turnaround, base.p95Turnaround)
+            << setw(11) << signedPercent(r.makespan, base.makespan) << "\n";
+    }
+    out << string(87, '=') << "\n";
+}
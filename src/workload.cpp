@@ -0,0 +1,79 @@
+// src/workload.cpp
+// Reading and writing workload (process list) files
+
+#include "workload.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+vector<Process> readWorkload(istream& in) {
+    vector<Process> processes;
+    string line;
+    int lineNumber = 0;
+    
+    while (getline(in, line)) {
+        lineNumber++;
+        
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == string::npos || line[first] == '#') {
+            continue;
+        }
+        if (processes.empty() && line.compare(first, 3, "pid") == 0) {
+            continue;
+        }
+        
+        for (char& c : line) {
+            if (c == ',' || c == ';') c = ' ';
+        }
+        
+        istringstream fields(line);
+        int pid, arrival, burst, priority = 0;
+        if (!(fields >> pid >> arrival >> burst)) {
+            throw runtime_error("workload line " + to_string(lineNumber) +
+                                ": expected pid, arrival and burst");
+        }
+        // An optional fourth field, which must be a whole integer
+        if (!(fields >> ws).eof() && (!(fields >> priority) || !(fields >> ws).eof())) {
+            throw runtime_error("workload line " + to_string(lineNumber) +
+                                ": priority must be an integer and the last field");
+        }
+        
+        if (arrival < 0 || burst <= 0) {
+            throw runtime_error("workload line " + to_string(lineNumber) +
+                                ": arrival must be >= 0 and burst > 0");
+        }
+        processes.push_back(Process(pid, arrival, burst, priority));
+    }
+    
+    return processes;
+}
+
+vector<Process> loadWorkload(const string& path) {
+    if (path == "-") {
+        return readWorkload(cin);
+    }
+    
+    ifstream file(path);
+    if (!file) {
+        throw runtime_error("cannot open workload file '" + path + "'");
+    }
+    return readWorkload(file);
+}
+
+void writeWorkloadHeader(ostream& out) {
+    out << "pid,arrival,burst,priority\n";
+}
+
+void writeWorkloadLine(ostream& out, const Process& p) {
+    out << p.pid << ',' << p.arrivalTime << ',' << p.burstTime << ','
+        << p.priority << '\n';
+}
+
+void writeWorkload(ostream& out, const vector<Process>& processes) {
+    writeWorkloadHeader(out);
+    for (const auto& p : processes) {
+        writeWorkloadLine(out, p);
+    }
+}
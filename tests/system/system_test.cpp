@@ -36,6 +36,16 @@ TEST(SystemTest, MultilevelQueue) {
     EXPECT_GT(mqs.getAverageTurnaroundTime(), 0);
 }
 
+TEST(SystemTest, PreemptivePriorityArrivalAtCompletion) {
+    // P2 outranks P1 and arrives on the tick P1 finishes
+    PreemptivePriorityScheduler pps(1);
+    pps.addProcess(Process(1, 0, 5, 5));
+    pps.addProcess(Process(2, 5, 3, 1));
+    pps.schedule();
+    EXPECT_DOUBLE_EQ(pps.getAverageTurnaroundTime(), 4.5);
+    EXPECT_EQ(pps.getMakespan(), 9);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
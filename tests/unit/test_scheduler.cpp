@@ -2,7 +2,29 @@
  * Unit Tests for CPU Scheduler - Google Test Framework
  */
 #include "scheduler.h"
+#include "batch.h"
+#include "workload.h"
+#include "workload_generator.h"
+#include "submission_channel.h"
+#include "metrics.h"
+#include "executor.h"
+#include "coroutine_task.h"
+#include "what_if.h"
+#include "arrival_order.h"
+#include "topology.h"
+#include "trace_import.h"
+#include "result_cache.h"
+#include "policy_advisor.h"
+#include "dashboard.h"
+#include "result_columns.h"
+#include "benchmark_baseline.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <map>
+#include <sstream>
+#include <thread>
 
 TEST(ProcessTest, Creation) {
     Process p(1, 0, 10, 2);
@@ -36,6 +58,1358 @@ TEST(SchedulerTest, MetricsCalculation) {
     EXPECT_GT(rr.getAverageTurnaroundTime(), 0);
 }
 
+TEST(WorkloadTest, ParsesCsvWithHeaderAndComments) {
+    std::istringstream in("pid,arrival,burst,priority\n# comment\n1,0,10,2\n\n2 3 5\n");
+    std::vector<Process> processes = readWorkload(in);
+    ASSERT_EQ(processes.size(), 2U);
+    EXPECT_EQ(processes[0].burstTime, 10);
+    EXPECT_EQ(processes[0].priority, 2);
+    EXPECT_EQ(processes[1].arrivalTime, 3);
+    EXPECT_EQ(processes[1].priority, 0);
+    
+    std::istringstream bad("1,0\n");
+    EXPECT_THROW(readWorkload(bad), std::runtime_error);
+    for (const char* line : {"1,0,5,high\n", "2,1,3,2x\n", "3,0,4,1,9\n", "4,0,5x\n"}) {
+        std::istringstream malformed(line);
+        EXPECT_THROW(readWorkload(malformed), std::runtime_error) << line;
+    }
+    std::istringstream spaced("5, 2, 7, 3 \r\n");
+    EXPECT_EQ(readWorkload(spaced).at(0).priority, 3);
+}
+
+TEST(BatchTest, ParsesOptions) {
+    const char* args[] = {"scheduler", "-w", "jobs.csv", "-a", "rr,mlfq", "-q", "2,8",
+                          "-c", "0", "-t", "summary", "-f", "csv"};
+    BatchOptions options;
+    std::string error;
+    ASSERT_TRUE(parseBatchArgs(13, const_cast<char**>(args), options, error)) << error;
+    EXPECT_EQ(options.workloadPath, "jobs.csv");
+    EXPECT_EQ(options.algorithms, std::vector<std::string>({"rr", "mlfq"}));
+    EXPECT_EQ(options.quanta, std::vector<int>({2, 8}));
+    EXPECT_EQ(options.contextSwitch, 0);
+    EXPECT_EQ(options.trace, TRACE_SUMMARY);
+    EXPECT_EQ(options.format, FORMAT_CSV);
+    
+    const char* badArgs[] = {"scheduler", "-w", "jobs.csv", "-a", "fifo"};
+    EXPECT_FALSE(parseBatchArgs(5, const_cast<char**>(badArgs), options, error));
+}
+
+TEST(BatchTest, RunsEachQuantumForQuantumAlgorithms) {
+    BatchOptions options;
+    options.algorithms = {"rr", "pp"};
+    options.quanta = {2, 4};
+    options.contextSwitch = 0;
+    std::vector<Process> workload = {Process(1, 0, 10, 1), Process(2, 0, 5, 2)};
+    
+    std::vector<RunResult> results = runBatch(options, workload);
+    ASSERT_EQ(results.size(), 3U);
+    EXPECT_EQ(results[0].algorithm, "Round Robin (q=2)");
+    EXPECT_EQ(results[2].quantum, 0);
+    EXPECT_EQ(results[0].makespan, 15);
+    EXPECT_EQ(results[2].numProcesses, 2U);
+}
+
+TEST(WorkloadGeneratorTest, SeededStreamIsDeterministicAndOrdered) {
+    WorkloadConfig config;
+    config.count = 5000;
+    config.seed = 7;
+    config.arrivals = ARRIVAL_BURSTY;
+    config.bursts = BURST_PARETO;
+    
+    WorkloadGenerator first(config);
+    WorkloadGenerator second(config);
+    int lastArrival = 0;
+    while (first.hasNext()) {
+        Process a = first.next();
+        Process b = second.next();
+        EXPECT_EQ(a.arrivalTime, b.arrivalTime);
+        EXPECT_EQ(a.burstTime, b.burstTime);
+        EXPECT_EQ(a.priority, b.priority);
+        EXPECT_GE(a.arrivalTime, lastArrival);
+        EXPECT_GE(a.burstTime, 1);
+        EXPECT_LE(a.burstTime, config.maxBurst);
+        EXPECT_LT(a.priority, (int)config.priorityWeights.size());
+        lastArrival = a.arrivalTime;
+    }
+    EXPECT_FALSE(second.hasNext());
+    EXPECT_EQ(first.generated(), 5000U);
+}
+
+TEST(WorkloadGeneratorTest, MatchesConfiguredMeans) {
+    WorkloadConfig config;
+    config.count = 200000;
+    config.bursts = BURST_LOGNORMAL;
+    config.meanBurst = 20.0;
+    config.arrivalRate = 0.5;
+    
+    std::vector<Process> processes = WorkloadGenerator(config).take(config.count);
+    double totalBurst = 0.0;
+    for (const auto& p : processes) totalBurst += p.burstTime;
+    
+    EXPECT_NEAR(totalBurst / processes.size(), 20.0, 1.0);
+    EXPECT_NEAR((double)processes.back().arrivalTime / processes.size(), 2.0, 0.1);
+    
+    // Bursts and lulls average out to the configured rate
+    config.arrivals = ARRIVAL_BURSTY;
+    config.arrivalRate = 0.05;
+    processes = WorkloadGenerator(config).take(config.count);
+    EXPECT_NEAR(processes.size() / (double)processes.back().arrivalTime, 0.05, 0.005);
+}
+
+TEST(WorkloadGeneratorTest, RefusesArrivalsPastIntRange) {
+    WorkloadConfig config;
+    config.count = 100;
+    config.arrivalRate = 1e-9;                // about 10^9 time units apart
+    WorkloadGenerator generator(config);
+    EXPECT_THROW(generator.take(config.count), std::runtime_error);
+}
+
+TEST(ArrivalOrderTest, RadixOrderIsAStableSort) {
+    FastRandom random(3);
+    std::vector<Process> processes;
+    for (int i = 0; i < 100000; i++) {
+        int arrival = (int)(random.next() % 50000) - 1000;   // many ties, some negative
+        processes.push_back(Process(i, arrival, 1, 0));
+    }
+    std::vector<Process> expected = processes;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const Process& a, const Process& b) { return a.arrivalTime < b.arrivalTime; });
+    
+    for (unsigned threads : {1u, 4u}) {
+        std::vector<uint32_t> order = arrivalOrder(processes, threads);
+        ASSERT_EQ(order.size(), expected.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            ASSERT_EQ(processes[order[i]].pid, expected[i].pid) << "threads=" << threads;
+        }
+    }
+    EXPECT_FALSE(isArrivalSorted(processes));
+    EXPECT_TRUE(isArrivalSorted(expected));
+}
+
+TEST(ArrivalOrderTest, SortedWorkloadsAreSharedByContent) {
+    WorkloadConfig config;
+    config.count = 1000;
+    std::vector<Process> workload = WorkloadGenerator(config).take(config.count);
+    std::reverse(workload.begin(), workload.end());
+    
+    auto first = sortedWorkload(workload);
+    auto second = sortedWorkload(workload);
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_TRUE(isArrivalSorted(*first));
+    
+    workload[0].burstTime++;
+    auto changed = sortedWorkload(workload);
+    EXPECT_NE(changed.get(), first.get());
+}
+
+TEST(OnlineSchedulerTest, StreamedRunMatchesSchedule) {
+    WorkloadConfig config;
+    config.count = 300;
+    config.bursts = BURST_PARETO;
+    WorkloadGenerator generator(config);
+    
+    // Distinct arrival times keep the order independent of sort stability
+    std::vector<Process> workload;
+    for (int i = 0; generator.hasNext(); i++) {
+        Process p = generator.next();
+        workload.push_back(Process(p.pid, i * 7, p.burstTime, p.priority));
+    }
+    
+    MultilevelFeedbackQueueScheduler batch(1);
+    batch.setTraceLevel(TRACE_NONE);
+    for (const auto& p : workload) batch.addProcess(p);
+    batch.schedule();
+    
+    MultilevelFeedbackQueueScheduler online(1);
+    online.setTraceLevel(TRACE_NONE);
+    std::vector<Process> completed;
+    for (const auto& p : workload) {
+        online.advanceUntil(p.arrivalTime);
+        online.submit(p);
+        online.drainCompleted(completed);
+    }
+    while (online.step()) {}
+    online.drainCompleted(completed);
+    
+    ASSERT_EQ(completed.size(), workload.size());
+    EXPECT_EQ(online.getInFlightCount(), 0U);
+    EXPECT_DOUBLE_EQ(online.getAverageWaitingTime(), batch.getAverageWaitingTime());
+    EXPECT_DOUBLE_EQ(online.getAverageResponseTime(), batch.getAverageResponseTime());
+    EXPECT_EQ(online.getMakespan(), batch.getMakespan());
+}
+
+TEST(OnlineSchedulerTest, AdvanceUntilAndSubmitWhileRunning) {
+    RoundRobinScheduler rr(2, 0);
+    rr.setTraceLevel(TRACE_NONE);
+    rr.submit(Process(1, 0, 4, 0));
+    rr.advanceUntil(3);
+    EXPECT_EQ(rr.getCurrentTime(), 3);
+    EXPECT_EQ(rr.getInFlightCount(), 1U);
+    
+    rr.submit(Process(2, 3, 2, 0));
+    rr.advanceUntil(100);
+    EXPECT_EQ(rr.getCurrentTime(), 100);
+    
+    std::vector<Process> completed;
+    ASSERT_EQ(rr.drainCompleted(completed), 2U);
+    EXPECT_EQ(completed[0].pid, 1);
+    EXPECT_EQ(completed[0].completionTime, 4);
+    EXPECT_EQ(completed[1].pid, 2);
+    EXPECT_EQ(completed[1].completionTime, 6);
+    EXPECT_EQ(rr.drainCompleted(completed), 0U);
+    EXPECT_FALSE(rr.step());
+}
+
+TEST(SubmissionChannelTest, ConcurrentProducersMergeInArrivalOrder) {
+    const int producers = 8;
+    const int perProducer = 20000;
+    SubmissionChannel channel(producers, 64);  // small rings force backpressure
+    
+    std::vector<std::thread> threads;
+    for (int id = 0; id < producers; id++) {
+        threads.emplace_back([&channel, id]() {
+            FastRandom random(id + 1);
+            int arrival = 0;
+            for (int i = 0; i < perProducer; i++) {
+                arrival += (int)(random.next() % 4);
+                channel.push(id, Process(id * perProducer + i, arrival, 1 + i % 7, id % 6));
+            }
+            channel.close(id);
+        });
+    }
+    
+    std::vector<int> nextIndex(producers, 0);
+    int lastArrival = 0;
+    size_t received = 0;
+    Process p(0, 0, 0);
+    while (!channel.finished()) {
+        while (channel.tryPop(p)) {
+            int lane = p.pid / perProducer;
+            EXPECT_EQ(p.pid % perProducer, nextIndex[lane]);
+            nextIndex[lane]++;
+            EXPECT_GE(p.arrivalTime, lastArrival);
+            lastArrival = p.arrivalTime;
+            received++;
+        }
+        std::this_thread::yield();
+    }
+    for (auto& t : threads) t.join();
+    
+    EXPECT_EQ(received, (size_t)producers * perProducer);
+}
+
+TEST(SubmissionChannelTest, FeedsRunningScheduler) {
+    const int producers = 4;
+    SubmissionChannel channel(producers, 16);
+    std::vector<std::thread> threads;
+    for (int id = 0; id < producers; id++) {
+        threads.emplace_back([&channel, id]() {
+            for (int i = 0; i < 500; i++) {
+                channel.push(id, Process(id * 1000 + i, i * 3 + id, 2, 0));
+            }
+            channel.close(id);
+        });
+    }
+    
+    RoundRobinScheduler rr(4, 0);
+    rr.setTraceLevel(TRACE_NONE);
+    std::vector<Process> completed;
+    while (!channel.finished()) {
+        channel.feed(rr);
+        rr.drainCompleted(completed);
+        std::this_thread::yield();
+    }
+    for (auto& t : threads) t.join();
+    while (rr.step()) {}
+    rr.drainCompleted(completed);
+    
+    EXPECT_EQ(completed.size(), 2000U);
+    EXPECT_EQ(rr.getProcessCount(), 2000U);
+}
+
+TEST(MetricsTest, StreamingStatSummaries) {
+    StreamingStat stat;
+    for (int v = 1; v <= 1000; v++) stat.add(v);
+    
+    EXPECT_EQ(stat.getCount(), 1000U);
+    EXPECT_DOUBLE_EQ(stat.getMean(), 500.5);
+    EXPECT_EQ(stat.getMin(), 1);
+    EXPECT_EQ(stat.getMax(), 1000);
+    EXPECT_NEAR(stat.getStdDev(), 288.67, 0.01);
+    EXPECT_EQ(stat.getPercentile(0.01), 10);
+    EXPECT_NEAR((double)stat.getPercentile(0.95), 950.0, 950.0 / 16);
+    
+    StreamingStat other;
+    other.add(5000);
+    stat.merge(other);
+    EXPECT_EQ(stat.getMax(), 5000);
+    EXPECT_EQ(stat.getCount(), 1001U);
+}
+
+TEST(FastForwardTest, BulkRotationsMatchTickByTickRuns) {
+    WorkloadConfig config;
+    config.count = 300;
+    config.arrivals = ARRIVAL_BURSTY;
+    config.bursts = BURST_PARETO;
+    config.meanBurst = 400;
+    std::vector<Process> workload = WorkloadGenerator(config).take(config.count);
+    
+    for (const std::string algorithm : {"rr", "mlq"}) {
+        for (int contextSwitch : {0, 2}) {
+            std::vector<std::unique_ptr<Scheduler>> runs;
+            for (bool fastForward : {false, true}) {
+                runs.push_back(makeScheduler(algorithm, 3, contextSwitch));
+                runs.back()->setTraceLevel(TRACE_NONE);
+                runs.back()->setFastForward(fastForward);
+                for (const auto& p : workload) runs.back()->addProcess(p);
+                runs.back()->schedule();
+            }
+            const auto& slow = runs[0]->getRetainedProcesses();
+            const auto& fast = runs[1]->getRetainedProcesses();
+            ASSERT_EQ(slow.size(), fast.size());
+            for (size_t i = 0; i < slow.size(); i++) {
+                EXPECT_EQ(fast[i].startTime, slow[i].startTime) << algorithm << " P" << slow[i].pid;
+                EXPECT_EQ(fast[i].completionTime, slow[i].completionTime) << algorithm << " P" << slow[i].pid;
+                EXPECT_EQ(fast[i].responseTime, slow[i].responseTime) << algorithm << " P" << slow[i].pid;
+            }
+            EXPECT_EQ(runs[1]->getContextSwitchCount(), runs[0]->getContextSwitchCount());
+            EXPECT_EQ(runs[1]->getSwitchTime(), runs[0]->getSwitchTime());
+        }
+    }
+    
+    // Online runs stop at the advanceUntil() horizon, as tick-by-tick runs do
+    RoundRobinScheduler slow(2, 1), fast(2, 1);
+    slow.setFastForward(false);
+    for (RoundRobinScheduler* scheduler : {&slow, &fast}) {
+        scheduler->setTraceLevel(TRACE_NONE);
+        scheduler->submit(Process(1, 0, 5000));
+        scheduler->submit(Process(2, 0, 3000));
+        scheduler->advanceUntil(1000);
+        scheduler->submit(Process(3, 1000, 10));
+        while (scheduler->step()) {}
+    }
+    EXPECT_EQ(fast.getCurrentTime(), slow.getCurrentTime());
+    EXPECT_DOUBLE_EQ(fast.getAverageResponseTime(), slow.getAverageResponseTime());
+    EXPECT_DOUBLE_EQ(fast.getAverageTurnaroundTime(), slow.getAverageTurnaroundTime());
+}
+
+TEST(MetricsTest, BulkAddMatchesAddPerValue) {
+    std::vector<int32_t> values;
+    for (int v = -3; v <= 40; v++) values.push_back(v);
+    for (int shift = 4; shift < 31; shift++) {
+        for (int delta : {-1, 0, 1}) values.push_back((1 << shift) + delta);
+    }
+    values.push_back(INT_MAX);
+    FastRandom random(3);
+    while (values.size() < 1000) values.push_back((int32_t)(random.next() % 100000));
+    
+    StreamingStat single, bulk;
+    for (int32_t v : values) single.add(v);
+    bulk.addAll(values.data(), values.size());
+    EXPECT_EQ(bulk.getCount(), single.getCount());
+    EXPECT_EQ(bulk.getSum(), single.getSum());
+    EXPECT_EQ(bulk.getMin(), -3);
+    EXPECT_EQ(bulk.getMax(), INT_MAX);
+    for (int i = 0; i <= 1000; i++) {
+        ASSERT_EQ(bulk.getPercentile(i / 1000.0), single.getPercentile(i / 1000.0)) << i;
+    }
+}
+
+TEST(MetricsTest, StreamingQuantileTracksMedianAndTail) {
+    StreamingQuantile median(0.5), tail(0.9);
+    EXPECT_EQ(median.get(), 0.0);
+    median.add(7);
+    median.add(3);
+    median.add(5);
+    EXPECT_EQ(median.get(), 5.0);  // exact while samples fit in the markers
+    
+    FastRandom random(11);
+    for (int i = 0; i < 100000; i++) {
+        double value = (double)(random.next() % 1000);
+        median.add(value);
+        tail.add(value);
+    }
+    EXPECT_NEAR(median.get(), 500.0, 15.0);
+    EXPECT_NEAR(tail.get(), 900.0, 15.0);
+}
+
+TEST(BurstPredictorTest, LearnsEachPriorityClassSeparately) {
+    ExponentialAveragePredictor average(0.5, 10.0);
+    Process shortJob(1, 0, 2, 0), longJob(2, 0, 40, 5);
+    average.observe(shortJob);
+    average.observe(longJob);
+    EXPECT_DOUBLE_EQ(average.predict(shortJob), 6.0);
+    EXPECT_DOUBLE_EQ(average.predict(longJob), 25.0);
+    EXPECT_DOUBLE_EQ(average.predict(Process(3, 0, 1, 9)), 25.0);  // shares the last class
+    
+    ClassQuantilePredictor median(0.5, 10.0);
+    EXPECT_DOUBLE_EQ(median.predict(shortJob), 10.0);
+    for (int burst : {3, 1, 2}) median.observe(Process(4, 0, burst, 0));
+    EXPECT_DOUBLE_EQ(median.predict(shortJob), 2.0);
+    
+    EXPECT_TRUE(makeBurstPredictor("exp:0.25") != nullptr);
+    EXPECT_TRUE(makeBurstPredictor("quantile") != nullptr);
+    EXPECT_TRUE(makeBurstPredictor("oracle")->isOracle());
+    EXPECT_EQ(makeBurstPredictor("exp:2"), nullptr);
+    EXPECT_EQ(makeBurstPredictor("lifo"), nullptr);
+}
+
+TEST(BurstPredictorTest, PredictedPoliciesApproachTheOracle) {
+    // Short interactive jobs and long batch jobs, told apart by priority only
+    std::vector<Process> workload;
+    for (int i = 0; i < 200; i++) {
+        workload.emplace_back(i + 1, i * 3, i % 2 ? 40 : 2, i % 2 ? 5 : 0);
+    }
+    auto run = [&](const std::string& algorithm, const std::string& predictor) {
+        auto scheduler = makeScheduler(algorithm, 0, 1, predictor);
+        scheduler->setTraceLevel(TRACE_NONE);
+        for (const auto& p : workload) scheduler->addProcess(p);
+        scheduler->schedule();
+        return scheduler;
+    };
+    
+    auto oracle = run("sjf", "oracle");
+    auto predicted = run("sjf", "exp");
+    EXPECT_EQ(predicted->getName(), "SJF (exp 0.5)");
+    EXPECT_EQ(predicted->getPredictionError().count, workload.size());
+    EXPECT_LT(predicted->getPredictionError().meanAbsolute(), 5.0);  // early guesses only
+    EXPECT_LE(oracle->getAverageWaitingTime(), predicted->getAverageWaitingTime());
+    EXPECT_LT(predicted->getAverageWaitingTime(), oracle->getAverageWaitingTime() * 1.05);
+    
+    // Bursts of one task share its pid; each keeps its own prediction
+    std::vector<Process> unique = workload;
+    for (size_t i = 0; i < workload.size(); i++) {
+        workload[i] = Process(i % 2 + 1, (int)i, i % 4 < 2 ? 2 : 40, 0);
+        unique[i] = Process(i + 1, (int)i, workload[i].burstTime, 0);
+    }
+    auto repeated = run("sjf", "oracle");
+    std::swap(workload, unique);
+    auto reference = run("sjf", "oracle");
+    EXPECT_EQ(repeated->getPredictionError().count, workload.size());
+    EXPECT_DOUBLE_EQ(repeated->getPredictionError().meanAbsolute(), 0.0);
+    EXPECT_DOUBLE_EQ(repeated->getAverageWaitingTime(), reference->getAverageWaitingTime());
+    std::swap(workload, unique);
+    
+    // Long jobs placed straight into Q2 skip two demotions each
+    auto plain = std::make_unique<MultilevelFeedbackQueueScheduler>(1);
+    plain->setTraceLevel(TRACE_NONE);
+    for (const auto& p : workload) plain->addProcess(p);
+    plain->schedule();
+    auto placed = run("pmlfq", "exp");
+    EXPECT_EQ(placed->getCompletedCount(), workload.size());
+    EXPECT_LT(placed->getContextSwitchCount(), plain->getContextSwitchCount());
+}
+
+TEST(AdaptiveRoundRobinTest, QuantumFollowsBurstsAndCutsSwitches) {
+    WorkloadConfig config;
+    config.count = 2000;
+    std::vector<Process> workload = WorkloadGenerator(config).take(config.count);
+    
+    RoundRobinScheduler fixed(2, 1);
+    AdaptiveRoundRobinScheduler adaptive(2, AdaptiveQuantum(), 1);
+    for (Scheduler* scheduler : {(Scheduler*)&fixed, (Scheduler*)&adaptive}) {
+        scheduler->setTraceLevel(TRACE_NONE);
+        for (const auto& p : workload) scheduler->addProcess(p);
+        scheduler->schedule();
+        EXPECT_EQ(scheduler->getCompletedCount(), workload.size());
+    }
+    EXPECT_LT(adaptive.getContextSwitchCount(), fixed.getContextSwitchCount());
+    EXPECT_LT(adaptive.getSwitchTime(), fixed.getSwitchTime());
+    EXPECT_GE(adaptive.getCurrentQuantum(), 9);  // 10% switch overhead floor at cost 1
+    
+    // The estimator state is part of a snapshot
+    AdaptiveRoundRobinScheduler interrupted(2, AdaptiveQuantum(), 1), resumed(2, AdaptiveQuantum(), 1);
+    interrupted.setTraceLevel(TRACE_NONE);
+    resumed.setTraceLevel(TRACE_NONE);
+    for (const auto& p : workload) {
+        interrupted.addProcess(p);
+        resumed.addProcess(p);
+    }
+    interrupted.advanceUntil(adaptive.getMakespan() / 2);
+    std::stringstream snapshot;
+    interrupted.saveState(snapshot);
+    resumed.loadState(snapshot);
+    while (resumed.step()) {}
+    EXPECT_DOUBLE_EQ(resumed.getAverageWaitingTime(), adaptive.getAverageWaitingTime());
+    EXPECT_EQ(resumed.getContextSwitchCount(), adaptive.getContextSwitchCount());
+}
+
+TEST(BoundedMemoryTest, AggregateRetentionRecyclesSlots) {
+    WorkloadConfig config;
+    config.count = 50000;
+    config.arrivalRate = 0.05;
+    WorkloadGenerator generator(config);
+    
+    MultilevelFeedbackQueueScheduler mlfq(1);
+    mlfq.setTraceLevel(TRACE_NONE);
+    mlfq.setRetention(RETAIN_AGGREGATES);
+    size_t peakResident = 0;
+    while (generator.hasNext()) {
+        Process p = generator.next();
+        mlfq.advanceUntil(p.arrivalTime);
+        mlfq.submit(p);
+        peakResident = std::max(peakResident, mlfq.getResidentCount());
+    }
+    while (mlfq.step()) {}
+    
+    std::vector<Process> completed;
+    EXPECT_EQ(mlfq.drainCompleted(completed), 0U);
+    EXPECT_EQ(mlfq.getCompletedCount(), 50000U);
+    EXPECT_EQ(mlfq.getAggregate().turnaround.getCount(), 50000U);
+    EXPECT_DOUBLE_EQ(mlfq.getAggregate().waiting.getMean(), mlfq.getAverageWaitingTime());
+    EXPECT_EQ(mlfq.getResidentCount(), 0U);
+    EXPECT_LT(peakResident, 1000U);
+}
+
+TEST(CheckpointTest, ResumedRunMatchesUninterruptedRun) {
+    WorkloadConfig config;
+    config.count = 400;
+    config.arrivals = ARRIVAL_BURSTY;
+    std::vector<Process> workload = WorkloadGenerator(config).take(config.count);
+    
+    for (const std::string algorithm : {"rr", "pp", "npp", "mlq", "mlfq", "sjf", "pmlfq"}) {
+        auto reference = makeScheduler(algorithm, 3, 1);
+        reference->setTraceLevel(TRACE_NONE);
+        for (const auto& p : workload) reference->addProcess(p);
+        reference->schedule();
+        
+        auto interrupted = makeScheduler(algorithm, 3, 1);
+        interrupted->setTraceLevel(TRACE_NONE);
+        for (const auto& p : workload) interrupted->addProcess(p);
+        interrupted->advanceUntil(reference->getMakespan() / 2);
+        std::stringstream snapshot;
+        interrupted->saveState(snapshot);
+        
+        auto resumed = makeScheduler(algorithm, 3, 1);
+        resumed->setTraceLevel(TRACE_NONE);
+        for (const auto& p : workload) resumed->addProcess(p);
+        resumed->loadState(snapshot);
+        EXPECT_EQ(resumed->getCurrentTime(), interrupted->getCurrentTime());
+        while (resumed->step()) {}
+        
+        EXPECT_EQ(resumed->getCompletedCount(), workload.size()) << algorithm;
+        EXPECT_DOUBLE_EQ(resumed->getAverageWaitingTime(), reference->getAverageWaitingTime()) << algorithm;
+        EXPECT_DOUBLE_EQ(resumed->getAverageResponseTime(), reference->getAverageResponseTime()) << algorithm;
+        EXPECT_EQ(resumed->getMakespan(), reference->getMakespan()) << algorithm;
+    }
+    
+    // A different workload of the same size must not resume the snapshot
+    auto interrupted = makeScheduler("rr", 3, 1);
+    interrupted->setTraceLevel(TRACE_NONE);
+    for (const auto& p : workload) interrupted->addProcess(p);
+    interrupted->advanceUntil(100);
+    std::stringstream snapshot;
+    interrupted->saveState(snapshot);
+    auto other = makeScheduler("rr", 3, 1);
+    for (auto p : workload) {
+        p.burstTime++;
+        other->addProcess(p);
+    }
+    EXPECT_THROW(other->loadState(snapshot), std::runtime_error);
+}
+
+TEST(CheckpointTest, StreamedSnapshotHoldsOnlyActiveState) {
+    WorkloadConfig config;
+    config.count = 20000;
+    std::vector<Process> workload = WorkloadGenerator(config).take(config.count);
+    
+    auto feed = [&](Scheduler& s, size_t from, size_t to) {
+        for (size_t i = from; i < to; i++) {
+            s.advanceUntil(workload[i].arrivalTime);
+            s.submit(workload[i]);
+        }
+    };
+    
+    MultilevelFeedbackQueueScheduler reference(1);
+    reference.setTraceLevel(TRACE_NONE);
+    reference.setRetention(RETAIN_AGGREGATES);
+    feed(reference, 0, workload.size());
+    while (reference.step()) {}
+    
+    MultilevelFeedbackQueueScheduler interrupted(1);
+    interrupted.setTraceLevel(TRACE_NONE);
+    interrupted.setRetention(RETAIN_AGGREGATES);
+    feed(interrupted, 0, 15000);
+    std::stringstream snapshot;
+    interrupted.saveState(snapshot);
+    EXPECT_LT(snapshot.str().size(), 64U * 1024U);
+    
+    MultilevelQueueScheduler wrongPolicy(4, 1);
+    std::stringstream copy(snapshot.str());
+    EXPECT_THROW(wrongPolicy.loadState(copy), std::runtime_error);
+    
+    MultilevelFeedbackQueueScheduler resumed(1);
+    resumed.setTraceLevel(TRACE_NONE);
+    resumed.loadState(snapshot);
+    feed(resumed, 15000, workload.size());
+    while (resumed.step()) {}
+    
+    EXPECT_EQ(resumed.getCompletedCount(), workload.size());
+    EXPECT_EQ(resumed.getMakespan(), reference.getMakespan());
+    EXPECT_DOUBLE_EQ(resumed.getAverageTurnaroundTime(), reference.getAverageTurnaroundTime());
+    EXPECT_EQ(resumed.getAggregate().turnaround.getPercentile(0.99),
+              reference.getAggregate().turnaround.getPercentile(0.99));
+}
+
+TEST(WhatIfTest, BranchesContinueFromTheForkedState) {
+    WorkloadConfig config;
+    config.count = 2000;
+    std::vector<Process> workload = WorkloadGenerator(config).take(config.count);
+    
+    RoundRobinScheduler reference(4, 1);
+    reference.setTraceLevel(TRACE_NONE);
+    for (const auto& p : workload) reference.addProcess(p);
+    reference.schedule();
+    
+    RoundRobinScheduler baseline(4, 1);
+    baseline.setTraceLevel(TRACE_NONE);
+    for (const auto& p : workload) baseline.addProcess(p);
+    baseline.advanceUntil(reference.getMakespan() / 3);
+    
+    // Same policy: the branch is indistinguishable from the baseline
+    RoundRobinScheduler sameBranch(4, 1);
+    sameBranch.setTraceLevel(TRACE_NONE);
+    sameBranch.branchFrom(baseline);
+    EXPECT_EQ(sameBranch.getInFlightCount(), baseline.getInFlightCount());
+    
+    // Another policy forked before anything ran behaves like a fresh run
+    PreemptivePriorityScheduler standalone(1);
+    standalone.setTraceLevel(TRACE_NONE);
+    for (const auto& p : workload) standalone.addProcess(p);
+    standalone.schedule();
+    
+    RoundRobinScheduler root(4, 1);
+    root.setTraceLevel(TRACE_NONE);
+    for (const auto& p : workload) root.addProcess(p);
+    root.advanceUntil(0);
+    PreemptivePriorityScheduler priorityBranch(1);
+    priorityBranch.setTraceLevel(TRACE_NONE);
+    priorityBranch.branchFrom(root);
+    
+    MultilevelFeedbackQueueScheduler mlfqBranch(1, 4, 8);
+    mlfqBranch.setTraceLevel(TRACE_NONE);
+    mlfqBranch.branchFrom(baseline);
+    EXPECT_EQ(mlfqBranch.getName(), "MLFQ (q=4/8)");
+    
+    while (baseline.step()) {}
+    while (sameBranch.step()) {}
+    while (priorityBranch.step()) {}
+    while (mlfqBranch.step()) {}
+    
+    EXPECT_DOUBLE_EQ(baseline.getAverageWaitingTime(), reference.getAverageWaitingTime());
+    EXPECT_DOUBLE_EQ(sameBranch.getAverageWaitingTime(), reference.getAverageWaitingTime());
+    EXPECT_EQ(sameBranch.getMakespan(), reference.getMakespan());
+    EXPECT_DOUBLE_EQ(priorityBranch.getAverageWaitingTime(), standalone.getAverageWaitingTime());
+    EXPECT_EQ(priorityBranch.getMakespan(), standalone.getMakespan());
+    EXPECT_EQ(mlfqBranch.getCompletedCount(), workload.size());
+    EXPECT_THROW(sameBranch.branchFrom(baseline), std::logic_error);
+}
+
+TEST(WhatIfTest, RunsBranchesSideBySideAgainstBaseline) {
+    BatchOptions options;
+    options.generate = true;
+    options.generator.count = 5000;
+    options.algorithms = {"mlfq", "rr", "mlfq"};
+    options.quanta = {2, 8};
+    options.branchTime = 20000;
+    
+    std::vector<RunResult> results = runWhatIf(options, {});
+    ASSERT_EQ(results.size(), 4U);
+    EXPECT_EQ(results[0].algorithm, "MLFQ");
+    EXPECT_EQ(results[1].algorithm, "Round Robin (q=2)");
+    EXPECT_EQ(results[2].algorithm, "Round Robin (q=8)");
+    for (const auto& r : results) {
+        EXPECT_EQ(r.numProcesses, 5000U);
+    }
+    EXPECT_DOUBLE_EQ(results[3].avgTurnaround, results[0].avgTurnaround);
+    EXPECT_EQ(results[3].makespan, results[0].makespan);
+    
+    std::ostringstream out;
+    writeComparison(out, results);
+    EXPECT_NE(out.str().find("+0.0%"), std::string::npos);
+}
+
+TEST(PolicyAdvisorTest, ProfilesEverythingAndRanksPrefixRuns) {
+    BatchOptions options;
+    options.generate = true;
+    options.generator.count = 20000;
+    options.advisePrefix = 2000;
+    options.quanta = {4};
+    
+    AdvisorReport report = adviseWorkload(options, {});
+    EXPECT_EQ(report.profile.processes, 20000U);
+    EXPECT_EQ(report.profile.bursts.getCount(), 20000U);
+    EXPECT_NEAR(report.profile.arrivalRate(), options.generator.arrivalRate, 0.01);
+    EXPECT_NEAR(report.profile.offeredLoad(), 0.8, 0.1);
+    uint64_t classified = 0;
+    for (uint64_t count : report.profile.priorities) classified += count;
+    EXPECT_EQ(classified, 20000U);
+    
+    // Every policy is raced on the prefix, best first
+    EXPECT_EQ(report.prefixProcesses, 2000U);
+    ASSERT_GE(report.candidates.size(), 8U);
+    for (size_t i = 0; i < report.candidates.size(); i++) {
+        EXPECT_EQ(report.candidates[i].result.numProcesses, 2000U);
+        if (i > 0) {
+            EXPECT_LE(report.candidates[i - 1].result.avgWaiting, report.candidates[i].result.avgWaiting);
+        }
+    }
+    
+    // The recommendation reproduces as a batch run of the same prefix
+    std::vector<Process> prefix = WorkloadGenerator(options.generator).take(2000);
+    const AdvisorCandidate& best = report.candidates.front();
+    auto scheduler = makeScheduler(best.algorithm, best.quantum, options.contextSwitch);
+    scheduler->setTraceLevel(TRACE_NONE);
+    for (const auto& p : prefix) scheduler->addProcess(p);
+    scheduler->schedule();
+    EXPECT_DOUBLE_EQ(scheduler->getAverageWaitingTime(), best.result.avgWaiting);
+    
+    std::ostringstream out;
+    writeAdvice(out, report, FORMAT_TABLE);
+    EXPECT_NE(out.str().find("Recommended: " + best.result.algorithm + "  (" + best.flags() + ")"),
+              std::string::npos);
+    
+    // Predicted policies name the predictor they were ranked with
+    for (const auto& candidate : report.candidates) {
+        bool predicted = candidate.algorithm == "sjf" || candidate.algorithm == "pmlfq";
+        EXPECT_EQ(candidate.flags().find(" --predictor " + options.predictor) != std::string::npos, predicted);
+    }
+    
+    // A workload that fails after the candidates started still throws
+    options.generator.count = 1000000;
+    options.generator.arrivalRate = 0.00001;
+    options.advisePrefix = 100;
+    EXPECT_THROW(adviseWorkload(options, {}), std::runtime_error);
+}
+
+// ftrace key=value lines, then perf script's compact form
+static const char* KERNEL_TRACE =
+    "# tracer: nop\n"
+    "  <idle>-0  [000] d..2  100.000000: sched_wakeup: comm=a pid=10 prio=120 target_cpu=000\n"
+    "  <idle>-0  [000] d..2  100.000000: sched_switch: prev_comm=swapper/0 prev_pid=0 prev_prio=120 "
+    "prev_state=R ==> next_comm=a next_pid=10 next_prio=120\n"
+    "       a-10 [000] d..3  100.001000: sched_wakeup: comm=b pid=11 prio=100 target_cpu=000\n"
+    "       a-10 [000] d..2  100.004000: sched_switch: prev_comm=a prev_pid=10 prev_prio=120 "
+    "prev_state=D ==> next_comm=b next_pid=11 next_prio=100\n"
+    "       b-11 [000] d..2  100.006000: sched_switch: prev_comm=b prev_pid=11 prev_prio=100 "
+    "prev_state=R+ ==> next_comm=swapper/0 next_pid=0 next_prio=120\n"
+    "  <idle>-0  [001] d..2  100.007000: sched_switch: prev_comm=swapper/1 prev_pid=0 prev_prio=120 "
+    "prev_state=R ==> next_comm=b next_pid=11 next_prio=100\n"
+    "       b-11 [001] d..2  100.009000: sched_switch: prev_comm=b prev_pid=11 prev_prio=100 "
+    "prev_state=S ==> next_comm=swapper/1 next_pid=0 next_prio=120\n"
+    " swapper     0 [000]   100.010000: sched:sched_wakeup: a:10 [120] success=1 CPU:000\n"
+    " swapper     0 [000]   100.010000: sched:sched_switch: swapper/0:0 [120] R ==> a:10 [120]\n"
+    "       a    10 [000]   100.012500: sched:sched_switch: a:10 [120] S ==> swapper/0:0 [120]\n";
+
+TEST(TraceImportTest, WakeupToBlockIntervalsBecomeBursts) {
+    std::vector<Process> bursts;
+    TraceImporter importer(TraceImportOptions(), [&](const Process& p) { bursts.push_back(p); });
+    std::string text = KERNEL_TRACE;
+    for (size_t i = 0; i < text.size(); i += 7) {
+        importer.feed(text.data() + i, std::min<size_t>(7, text.size() - i));
+    }
+    importer.finish();
+
+    ASSERT_EQ(bursts.size(), 3U);
+    EXPECT_EQ(bursts[0].pid, 1);
+    EXPECT_EQ(bursts[0].burstTime, 4);
+    EXPECT_EQ(bursts[0].priority, 3);
+    EXPECT_EQ(bursts[1].arrivalTime, 1);
+    EXPECT_EQ(bursts[1].burstTime, 4);      // preempted (R+) and resumed on CPU 1
+    EXPECT_EQ(bursts[1].priority, 1);
+    EXPECT_EQ(bursts[2].arrivalTime, 10);
+    EXPECT_EQ(bursts[2].burstTime, 3);
+
+    const TraceImportStats& stats = importer.getStats();
+    EXPECT_EQ(stats.events, 10U);
+    EXPECT_EQ(stats.cpus, 2);
+    EXPECT_EQ(stats.migrations, 1U);
+    EXPECT_EQ(stats.ioWaits, 1U);
+    EXPECT_EQ(stats.ioWaitTime, 6);
+    EXPECT_EQ(stats.truncatedBursts, 0U);
+    EXPECT_EQ(stats.makespan, 13);
+    EXPECT_EQ(stats.kernel.waiting.getMax(), 4);
+    EXPECT_EQ(stats.kernel.response.getMax(), 3);
+
+    // The mapped-file path sees the same stream
+    std::string path = ::testing::TempDir() + "kernel_trace.txt";
+    std::ofstream(path) << KERNEL_TRACE;
+    std::vector<Process> mapped;
+    TraceImportStats fileStats = importTrace(path, TraceImportOptions(),
+                                             [&](const Process& p) { mapped.push_back(p); });
+    ASSERT_EQ(mapped.size(), bursts.size());
+    EXPECT_EQ(mapped[1].burstTime, bursts[1].burstTime);
+    EXPECT_EQ(fileStats.lines, stats.lines);
+    EXPECT_THROW(importTrace(path + ".missing", TraceImportOptions(), [](const Process&) {}),
+                 std::runtime_error);
+}
+
+TEST(TraceImportTest, TraceFilesAreStreamedIntoEachRun) {
+    std::string path = ::testing::TempDir() + "streamed_trace.txt";
+    std::ofstream(path) << KERNEL_TRACE;
+    std::vector<Process> bursts;
+    importTrace(path, TraceImportOptions(), [&](const Process& p) { bursts.push_back(p); });
+    
+    BatchOptions loaded;
+    loaded.algorithms = {"rr", "mlfq"};
+    BatchOptions streamed = loaded;
+    streamed.schedTracePath = path;
+    EXPECT_TRUE(streamsWorkload(streamed));
+    EXPECT_EQ(workloadKey(streamed, {}), workloadKey(loaded, bursts));
+    
+    std::vector<RunResult> expected = runBatch(loaded, bursts);
+    std::vector<RunResult> results = runBatch(streamed, {});
+    ASSERT_EQ(results.size(), expected.size());
+    for (size_t i = 0; i < results.size(); i++) {
+        EXPECT_EQ(results[i].numProcesses, bursts.size());
+        EXPECT_DOUBLE_EQ(results[i].avgWaiting, expected[i].avgWaiting);
+        EXPECT_EQ(results[i].makespan, expected[i].makespan);
+    }
+}
+
+TEST(TraceImportTest, CacheSummaryCountsOnlySimulatedRuns) {
+    std::string path = ::testing::TempDir() + "cached_trace.txt";
+    std::string dir = ::testing::TempDir() + "trace_cache";
+    std::string output = ::testing::TempDir() + "trace_cache.txt";
+    std::ofstream(path) << KERNEL_TRACE;
+    std::filesystem::remove_all(dir);
+    
+    const char* args[] = {"scheduler", "--sched-trace", path.c_str(), "-a", "rr", "--cache", dir.c_str(),
+                          "-o", output.c_str()};
+    for (int pass = 0; pass < 2; pass++) {
+        ASSERT_EQ(batchMain(9, const_cast<char**>(args)), 0);
+    }
+    std::ifstream in(output);
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_NE(text.find("Result cache: 1 of 1 run(s)"), std::string::npos) << text;
+    std::filesystem::remove_all(dir);
+}
+
+TEST(TraceImportTest, TaskThatNeverSleepsDoesNotHoldBackLaterBursts) {
+    // Task 10 runs on CPU 0 for the whole trace; task 11 wakes and sleeps
+    // on CPU 1 every millisecond
+    std::string text =
+        "  <idle>-0  [000] d..2  100.000000: sched_switch: prev_comm=swapper/0 prev_pid=0 prev_prio=120 "
+        "prev_state=R ==> next_comm=spin next_pid=10 next_prio=120\n";
+    for (int i = 1; i <= 100; i++) {
+        char at[16], end[16];
+        snprintf(at, sizeof(at), "%d.%06d", 100 + i / 1000, (i % 1000) * 1000);
+        snprintf(end, sizeof(end), "%d.%06d", 100 + i / 1000, (i % 1000) * 1000 + 500);
+        text += std::string("  <idle>-0  [001] d..2  ") + at + ": sched_wakeup: comm=io pid=11 prio=120\n";
+        text += std::string("  <idle>-0  [001] d..2  ") + at + ": sched_switch: prev_comm=swapper/1 prev_pid=0 "
+                "prev_prio=120 prev_state=R ==> next_comm=io next_pid=11 next_prio=120\n";
+        text += std::string("      io-11 [001] d..2  ") + end + ": sched_switch: prev_comm=io prev_pid=11 "
+                "prev_prio=120 prev_state=S ==> next_comm=swapper/1 next_pid=0 next_prio=120\n";
+    }
+    
+    TraceImportOptions options;
+    options.maxHeldBursts = 8;
+    std::vector<Process> bursts;
+    TraceImporter importer(options, [&](const Process& p) { bursts.push_back(p); });
+    importer.feed(text.data(), text.size());
+    EXPECT_GE(bursts.size(), 90U);          // handed out while the spinning task still runs
+    importer.finish();
+    
+    const TraceImportStats& stats = importer.getStats();
+    EXPECT_GT(stats.splitBursts, 0U);
+    EXPECT_EQ(stats.bursts, 100U + stats.splitBursts + 1);
+    long long spinTime = 0;
+    for (size_t i = 1; i < bursts.size(); i++) {
+        EXPECT_LE(bursts[i - 1].arrivalTime, bursts[i].arrivalTime);
+    }
+    for (const auto& p : bursts) {
+        if (p.burstTime != 1) spinTime += p.burstTime;   // io bursts are 0.5 ms, rounded up to 1
+    }
+    EXPECT_NEAR(spinTime, 100, stats.splitBursts + 1);
+}
+
+TEST(TraceImportTest, ArrivalsRoundLikeKernelTimesAndLongTracesAreRejected) {
+    auto trace = [](const char* later) {
+        return std::string("  <idle>-0  [000] d..2  100.000000: sched_wakeup: comm=a pid=10 prio=120\n"
+                           "  <idle>-0  [000] d..2  100.000000: sched_switch: prev_comm=swapper/0 prev_pid=0 "
+                           "prev_prio=120 prev_state=R ==> next_comm=a next_pid=10 next_prio=120\n"
+                           "       a-10 [000] d..2  ") + later + ": sched_switch: prev_comm=a prev_pid=10 "
+               "prev_prio=120 prev_state=S ==> next_comm=swapper/0 next_pid=0 next_prio=120\n"
+               "  <idle>-0  [000] d..2  " + later + ": sched_wakeup: comm=b pid=11 prio=120\n";
+    };
+    std::vector<Process> bursts;
+    TraceImporter importer(TraceImportOptions(), [&](const Process& p) { bursts.push_back(p); });
+    std::string text = trace("100.001600");
+    importer.feed(text.data(), text.size());
+    importer.finish();
+    ASSERT_EQ(bursts.size(), 2U);
+    EXPECT_EQ(bursts[1].arrivalTime, 2);    // 1.6 ticks, rounded like the kernel times
+    EXPECT_EQ(importer.getStats().makespan, 2);
+    
+    TraceImportOptions fine;
+    fine.tickMicros = 1;
+    TraceImporter tooLong(fine, [](const Process&) {});
+    text = trace("2600.000000");            // 2.5e9 microseconds later
+    EXPECT_THROW({
+        tooLong.feed(text.data(), text.size());
+        tooLong.finish();
+    }, std::runtime_error);
+}
+
+TEST(TopologyTest, SingleCpuWithoutPenaltiesMatchesPlainRun) {
+    CpuTopology topology = CpuTopology::parse("2x8x2");
+    EXPECT_EQ(topology.cpuCount(), 32);
+    EXPECT_EQ(topology.distance(4, 5), SMT_SIBLING);
+    EXPECT_EQ(topology.distance(4, 6), SAME_SOCKET);
+    EXPECT_EQ(topology.distance(4, 16), REMOTE_SOCKET);
+    EXPECT_THROW(CpuTopology::parse("2x0x2"), std::invalid_argument);
+    EXPECT_THROW(CpuTopology::parse("2x8"), std::invalid_argument);
+    
+    TopologyOptions options;
+    options.costs.coreMiss = options.costs.llcMiss = options.costs.remoteMemory = 0;
+    TopologySimulator machine(options, [] { return std::make_unique<RoundRobinScheduler>(3, 1); });
+    RoundRobinScheduler plain(3, 1);
+    plain.setTraceLevel(TRACE_NONE);
+    
+    WorkloadConfig config;
+    config.count = 2000;
+    config.arrivalRate = 0.12;
+    WorkloadGenerator generator(config);
+    while (generator.hasNext()) {
+        Process p = generator.next();
+        machine.submit(p);
+        plain.addProcess(p);
+    }
+    machine.finish();
+    plain.schedule();
+    
+    EXPECT_EQ(machine.getCompletedCount(), 2000U);
+    EXPECT_EQ(machine.getMakespan(), plain.getMakespan());
+    EXPECT_DOUBLE_EQ(machine.getAggregate().waiting.getMean(), plain.getAverageWaitingTime());
+    EXPECT_EQ(machine.getCounters().migrations(), 0U);
+    EXPECT_GT(machine.getCounters().cacheMisses(), 0U);
+}
+
+TEST(TopologyTest, BalancerMigrationsFollowPlacementPolicy) {
+    // Alternating placement leaves CPU 0 with the short jobs; once they
+    // finish, CPU 1 has two more processes than CPU 0
+    auto run = [](PlacementPolicy placement, bool samePid = false) {
+        TopologyOptions options;
+        options.topology = CpuTopology(2, 1, 1);
+        options.placement = placement;
+        TopologySimulator machine(options, [] { return std::make_unique<RoundRobinScheduler>(4, 1); });
+        int bursts[] = {2, 60, 2, 60, 60, 60};
+        for (int i = 0; i < 6; i++) {
+            machine.submit(Process(samePid ? 1 : i + 1, 0, bursts[i]));
+        }
+        machine.finish();
+        EXPECT_EQ(machine.getCompletedCount(), 6U);
+        EXPECT_EQ(machine.getCpu(0).getCompletedCount() + machine.getCpu(1).getCompletedCount(), 6U);
+        return machine.getCounters();
+    };
+    
+    TopologyCounters spread = run(PLACE_SMT_AWARE);
+    EXPECT_GE(spread.socketMigrations, 1U);
+    EXPECT_GE(spread.remoteDispatches, 1U);
+    EXPECT_GT(spread.penaltyTime, 0);
+    
+    // Reused pids still get their own cache warmth
+    TopologyCounters reused = run(PLACE_SMT_AWARE, true);
+    EXPECT_EQ(reused.cacheMisses(), spread.cacheMisses());
+    EXPECT_EQ(reused.migrations(), spread.migrations());
+    EXPECT_EQ(reused.penaltyTime, spread.penaltyTime);
+    
+    TopologyCounters local = run(PLACE_NUMA_LOCAL);
+    EXPECT_EQ(local.migrations(), 0U);
+    EXPECT_EQ(local.remoteDispatches, 0U);
+    
+    const char* args[] = {"scheduler", "-g", "100", "--topology", "2x8x2", "--placement", "numa",
+                          "--cache-penalties", "1,4,3"};
+    BatchOptions batch;
+    std::string error;
+    ASSERT_TRUE(parseBatchArgs(9, const_cast<char**>(args), batch, error)) << error;
+    EXPECT_TRUE(batch.useTopology);
+    EXPECT_EQ(batch.topology.placement, PLACE_NUMA_LOCAL);
+    EXPECT_EQ(batch.topology.costs.llcMiss, 4);
+    std::vector<RunResult> results = runBatch(batch, {});
+    EXPECT_EQ(results[0].cpus, 32);
+}
+
+TEST(ResultCacheTest, RepeatedRunsAreServedFromTheCache) {
+    std::string dir = ::testing::TempDir() + "result_cache_test";
+    std::filesystem::remove_all(dir);
+    BatchOptions options;
+    options.algorithms = {"rr", "mlfq"};
+    options.quanta = {2};
+    options.cacheDir = dir;
+    std::vector<Process> workload = {Process(1, 0, 10, 1), Process(2, 1, 5, 2), Process(3, 2, 7, 0)};
+    
+    std::vector<RunResult> first = runBatch(options, workload);
+    std::vector<RunResult> second = runBatch(options, workload);
+    ASSERT_EQ(second.size(), first.size());
+    for (size_t i = 0; i < first.size(); i++) {
+        EXPECT_FALSE(first[i].cached);
+        EXPECT_TRUE(second[i].cached);
+        EXPECT_EQ(second[i].algorithm, first[i].algorithm);
+        EXPECT_DOUBLE_EQ(second[i].avgWaiting, first[i].avgWaiting);
+        EXPECT_DOUBLE_EQ(second[i].avgResponse, first[i].avgResponse);
+        EXPECT_EQ(second[i].makespan, first[i].makespan);
+    }
+    
+    // The per-process rows come back with the entry
+    ResultCache cache(dir);
+    RunResult hit;
+    std::string rows = dir + "/rows.csv";
+    ASSERT_TRUE(cache.load(runKey(workloadKey(options, workload), "rr", 2, options), hit, rows));
+    std::ifstream in(rows);
+    std::string line;
+    int lines = 0;
+    while (std::getline(in, line)) lines++;
+    EXPECT_EQ(lines, 4);
+    
+    // Any change to the workload or configuration is a different run
+    options.contextSwitch = 0;
+    EXPECT_FALSE(runBatch(options, workload)[0].cached);
+    workload[2].burstTime = 8;
+    EXPECT_FALSE(runBatch(options, workload)[0].cached);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(BatchTest, CheckpointedFileRunsSnapshotOnlyActiveState) {
+    std::string prefix = ::testing::TempDir() + "batch_checkpoint";
+    WorkloadConfig config;
+    config.count = 20000;
+    std::vector<Process> workload = WorkloadGenerator(config).take(config.count);
+    BatchOptions options;
+    options.algorithms = {"mlfq"};
+    RunResult plain = runBatch(options, workload)[0];
+    
+    options.checkpointPrefix = prefix;
+    options.checkpointInterval = 50000;
+    std::string path = prefix + "-mlfq.ckpt";
+    std::filesystem::remove(path);
+    RunResult checkpointed = runBatch(options, workload)[0];
+    EXPECT_DOUBLE_EQ(checkpointed.avgWaiting, plain.avgWaiting);
+    EXPECT_EQ(checkpointed.makespan, plain.makespan);
+    EXPECT_LT(std::filesystem::file_size(path), 64U * 1024U);
+    std::filesystem::remove(path);
+}
+
+TEST(PhaseProfileTest, PhasesAreCountedOnlyInProfilingBuilds) {
+    RoundRobinScheduler scheduler(2, 1);
+    scheduler.setTraceLevel(TRACE_NONE);
+    scheduler.addProcess(Process(1, 0, 5));
+    scheduler.addProcess(Process(2, 1, 3));
+    scheduler.schedule();
+    
+    const PhaseProfile& profile = scheduler.getPhaseProfile();
+    if (!phaseProfilingEnabled()) {
+        EXPECT_EQ(profile.ticks, 0U);
+        EXPECT_EQ(profile.totalCycles(), 0U);
+        return;
+    }
+    EXPECT_GT(profile.ticks, 0U);
+    EXPECT_EQ(profile.calls[PHASE_ADMIT], profile.ticks);
+    EXPECT_EQ(profile.calls[PHASE_RETIRE], 2U);
+    EXPECT_GE(profile.calls[PHASE_REQUEUE], 2U);
+    EXPECT_EQ(profile.calls[PHASE_CHECKPOINT], 0U);
+    
+    PhaseProfile merged;
+    merged.merge(profile);
+    merged.merge(profile);
+    EXPECT_EQ(merged.calls[PHASE_RETIRE], 4U);
+    std::ostringstream json;
+    merged.writeJson(json);
+    EXPECT_NE(json.str().find("\"retire\": {\"calls\": 4"), std::string::npos);
+}
+
+TEST(DashboardTest, SnapshotsArePublishedOnlyWhenRequested) {
+    MultilevelFeedbackQueueScheduler scheduler(0);
+    scheduler.setTraceLevel(TRACE_NONE);
+    SnapshotChannel channel;
+    scheduler.setSnapshotChannel(&channel);
+    scheduler.submit(Process(1, 0, 30));
+    scheduler.submit(Process(2, 0, 4));
+    scheduler.submit(Process(3, 2, 6));
+    
+    SchedulerSnapshot snapshot;
+    scheduler.advanceUntil(3);
+    EXPECT_FALSE(channel.latest(snapshot));
+    
+    // A request is served at the end of the next tick, once
+    channel.request();
+    scheduler.advanceUntil(4);
+    ASSERT_TRUE(channel.latest(snapshot));
+    EXPECT_EQ(snapshot.time, 4);
+    EXPECT_EQ(snapshot.levels, 3);
+    EXPECT_STREQ(snapshot.levelNames[0], "Q0");
+    EXPECT_EQ(snapshot.admitted, 3U);
+    EXPECT_EQ(snapshot.busyTime, 4);
+    EXPECT_FALSE(channel.wanted());
+    scheduler.advanceUntil(5);
+    EXPECT_FALSE(channel.latest(snapshot));
+    EXPECT_EQ(snapshot.time, 4);
+    
+    while (scheduler.step()) {}
+    scheduler.publishSnapshot();
+    ASSERT_TRUE(channel.latest(snapshot));
+    EXPECT_EQ(snapshot.completed, 3U);
+    EXPECT_EQ(snapshot.runningPid, -1);
+    EXPECT_EQ(snapshot.busyTime, 40);
+    EXPECT_EQ(snapshot.levelLengths[0] + snapshot.levelLengths[1] + snapshot.levelLengths[2], 0U);
+}
+
+TEST(DashboardTest, DrawsAFinalFrameOnStop) {
+    std::ostringstream screen;
+    Dashboard dashboard(screen, 50);
+    RoundRobinScheduler scheduler(3, 1);
+    scheduler.setTraceLevel(TRACE_NONE);
+    scheduler.setSnapshotChannel(&dashboard.getChannel());
+    scheduler.addProcess(Process(1, 0, 5));
+    scheduler.addProcess(Process(2, 1, 3));
+    
+    dashboard.start(scheduler.getName());
+    scheduler.schedule();
+    scheduler.publishSnapshot();
+    dashboard.stop();
+    EXPECT_GE(dashboard.getFrames(), 1U);
+    EXPECT_NE(screen.str().find("completed 2 / 2"), std::string::npos);
+    EXPECT_NE(screen.str().find("CPU: IDLE"), std::string::npos);
+}
+
+TEST(ResultColumnsTest, ColumnarMetricsMatchPerProcessMetrics) {
+    WorkloadConfig config;
+    config.count = 2500;  // two full blocks and a partial one
+    config.seed = 11;
+    std::vector<Process> workload = WorkloadGenerator(config).take(config.count);
+    
+    for (const std::string algorithm : {"rr", "pp", "mlq", "mlfq"}) {
+        SCOPED_TRACE(algorithm);
+        auto scheduler = makeScheduler(algorithm, 4, 1);
+        scheduler->setTraceLevel(TRACE_NONE);
+        ResultColumns columns;
+        scheduler->setResultColumns(&columns);
+        for (const auto& p : workload) {
+            scheduler->addProcess(p);
+        }
+        scheduler->schedule();
+        ASSERT_EQ(columns.size(), workload.size());
+        
+        std::map<int, const Process*> byPid;
+        for (const auto& p : scheduler->getRetainedProcesses()) {
+            byPid[p.pid] = &p;
+        }
+        DerivedMetrics derived;
+        deriveMetrics(columns, derived);
+        for (size_t row = 0; row < columns.size(); row++) {
+            const Process* p = byPid.at(columns.pid[row]);
+            ASSERT_EQ(derived.waiting[row], p->waitingTime);
+            ASSERT_EQ(derived.turnaround[row], p->turnaroundTime);
+            ASSERT_EQ(derived.response[row], p->responseTime);
+        }
+        
+        MetricsBreakdown breakdown = analyzeResults(columns);
+        const MetricsAggregate& expected = scheduler->getAggregate();
+        for (auto [actual, reference] : {std::make_pair(&breakdown.overall.waiting, &expected.waiting),
+                                         std::make_pair(&breakdown.overall.turnaround, &expected.turnaround),
+                                         std::make_pair(&breakdown.overall.response, &expected.response)}) {
+            EXPECT_EQ(actual->getCount(), reference->getCount());
+            EXPECT_EQ(actual->getSum(), reference->getSum());
+            EXPECT_EQ(actual->getMin(), reference->getMin());
+            EXPECT_EQ(actual->getMax(), reference->getMax());
+            EXPECT_EQ(actual->getPercentile(0.50), reference->getPercentile(0.50));
+            EXPECT_EQ(actual->getPercentile(0.99), reference->getPercentile(0.99));
+            EXPECT_NEAR(actual->getStdDev(), reference->getStdDev(), 1e-6 * reference->getStdDev());
+        }
+        EXPECT_DOUBLE_EQ(breakdown.overall.waiting.getMean(), scheduler->getAverageWaitingTime());
+        
+        MetricsGroup total;
+        for (const auto& group : breakdown.byPriority) {
+            total.count += group.count;
+            total.waiting += group.waiting;
+        }
+        EXPECT_EQ(total.count, workload.size());
+        EXPECT_EQ(total.waiting, expected.waiting.getSum());
+        uint64_t levelled = 0;
+        for (int level = 0; level < breakdown.levels; level++) {
+            levelled += breakdown.byLevel[level].count;
+        }
+        EXPECT_EQ(levelled, workload.size());
+        EXPECT_EQ(breakdown.levels, algorithm == "mlq" || algorithm == "mlfq" ? 3 : 1);
+        
+        // MLQ levels follow the priority bands; MLFQ ones the 8/16 quanta a
+        // burst exhausts, since nothing preempts a running process
+        uint64_t expectedLevels[3] = {0, 0, 0};
+        for (const auto& p : workload) {
+            if (algorithm == "mlq") expectedLevels[p.priority <= 1 ? 0 : (p.priority <= 3 ? 1 : 2)]++;
+            if (algorithm == "mlfq") expectedLevels[p.burstTime <= 8 ? 0 : (p.burstTime <= 24 ? 1 : 2)]++;
+        }
+        if (breakdown.levels == 3) {
+            for (int level = 0; level < 3; level++) {
+                EXPECT_EQ(breakdown.byLevel[level].count, expectedLevels[level]) << "level " << level;
+            }
+        }
+    }
+    
+    // A short job that reuses a demoted job's pid still finishes in Q0
+    MultilevelFeedbackQueueScheduler mlfq;
+    mlfq.setTraceLevel(TRACE_NONE);
+    ResultColumns columns;
+    mlfq.setResultColumns(&columns);
+    mlfq.addProcess(Process(1, 0, 30, 3));
+    mlfq.addProcess(Process(1, 5, 2, 3));
+    mlfq.schedule();
+    MetricsBreakdown breakdown = analyzeResults(columns);
+    EXPECT_EQ(breakdown.byLevel[0].count, 1U);
+    EXPECT_EQ(breakdown.byLevel[1].count, 0U);
+    EXPECT_EQ(breakdown.byLevel[2].count, 1U);
+}
+
+TEST(BenchmarkBaselineTest, RoundTripsAndFlagsSlowdownsAndDrift) {
+    RoundRobinScheduler scheduler(2, 1);
+    scheduler.setTraceLevel(TRACE_NONE);
+    scheduler.addProcess(Process(1, 0, 5));
+    scheduler.addProcess(Process(2, 1, 3));
+    scheduler.schedule();
+    SimulatedOutcome outcome = outcomeOf(scheduler);
+    EXPECT_EQ(outcome.completed, 2U);
+    EXPECT_EQ(outcome.waiting, (long long)(scheduler.getAverageWaitingTime() * 2));
+    
+    std::vector<double> steady = {10.0, 10.4, 9.8, 10.1, 10.3, 9.9, 10.2, 10.0, 10.5, 9.7};
+    std::vector<double> slower;
+    for (double ms : steady) slower.push_back(ms * 1.3);
+    std::vector<BenchmarkCase> baseline = {{"rr", 1000, outcome, steady}, {"mlfq", 1000, outcome, steady},
+                                           {CALIBRATION_CASE, 0, SimulatedOutcome(), {4.0, 4.1, 3.9}}};
+    std::stringstream file;
+    saveBaseline(file, baseline);
+    std::vector<BenchmarkCase> loaded = loadBaseline(file);
+    ASSERT_EQ(loaded.size(), 3U);
+    EXPECT_EQ(loaded[0].outcome, outcome);
+    EXPECT_EQ(loaded[1].samplesMs, steady);
+    
+    EXPECT_GT(mannWhitneyPValue(steady, steady), 0.9);
+    EXPECT_LT(mannWhitneyPValue(steady, slower), 0.001);
+    
+    SimulatedOutcome drifted = outcome;
+    drifted.makespan++;
+    std::vector<BenchmarkCase> current = {{"rr", 1000, outcome, slower}, {"mlfq", 1000, drifted, steady},
+                                          {"sjf", 1000, outcome, steady},
+                                          {CALIBRATION_CASE, 0, SimulatedOutcome(), {4.0, 4.1, 3.9}}};
+    BaselineComparison comparison = compareToBaseline(loaded, current);
+    ASSERT_EQ(comparison.cases.size(), 3U);
+    EXPECT_DOUBLE_EQ(comparison.machineFactor, 1.0);
+    EXPECT_EQ(comparison.cases[0].timing, TIMING_SLOWER);
+    EXPECT_NEAR(comparison.cases[0].change, 0.3, 1e-9);
+    EXPECT_EQ(comparison.cases[1].timing, TIMING_UNCHANGED);
+    EXPECT_EQ(comparison.cases[1].drift, "makespan");
+    EXPECT_EQ(comparison.cases[2].timing, TIMING_NEW);
+    std::ostringstream table;
+    EXPECT_EQ(writeComparison(table, comparison), 2U);
+    
+    // The same slowdown on a machine that is 30% slower overall is no regression
+    current[3].samplesMs = {5.2, 5.33, 5.07};
+    comparison = compareToBaseline(loaded, current);
+    EXPECT_NEAR(comparison.machineFactor, 1.3, 1e-9);
+    EXPECT_EQ(comparison.cases[0].timing, TIMING_UNCHANGED);
+    
+    std::istringstream stale("benchmark-baseline 0\n");
+    EXPECT_THROW(loadBaseline(stale), std::runtime_error);
+}
+
+// Busy work for executor tests: yields at every unit boundary
+static TaskBody spinningTask(int units, std::vector<int>* levels = nullptr) {
+    auto remaining = std::make_shared<int>(units);
+    return [remaining, levels](TaskContext& context) {
+        while (*remaining > 0) {
+            auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(50);
+            while (std::chrono::steady_clock::now() < until) {}
+            (*remaining)--;
+            if (levels) levels->push_back(context.getLevel());
+            if (*remaining > 0 && context.shouldYield()) return false;
+        }
+        return true;
+    };
+}
+
+TEST(ExecutorTest, CompletesAllTasksUnderEachPolicy) {
+    for (ExecutorPolicy policy : {EXEC_ROUND_ROBIN, EXEC_PRIORITY, EXEC_MLFQ}) {
+        TaskExecutor executor(policy, 4, 100);
+        executor.start();
+        for (int i = 0; i < 64; i++) {
+            executor.submit(spinningTask(1 + i % 6), i % 6);
+        }
+        executor.waitIdle();
+        
+        std::vector<Process> records;
+        ASSERT_EQ(executor.drainCompleted(records), 64U);
+        ExecutorReport report = executor.report();
+        EXPECT_EQ(report.completedTasks, 64U);
+        EXPECT_GE(report.dispatches, 64U);
+        EXPECT_GT(report.throughput, 0.0);
+        for (const auto& r : records) {
+            EXPECT_EQ(r.state, TERMINATED);
+            EXPECT_GT(r.burstTime, 0);
+            EXPECT_GE(r.turnaroundTime, r.burstTime);
+        }
+    }
+}
+
+TEST(ExecutorTest, PriorityPolicyRunsHigherPriorityFirst) {
+    TaskExecutor executor(EXEC_PRIORITY, 1);
+    int low = executor.submit(spinningTask(2), 5);
+    int high = executor.submit(spinningTask(2), 0);
+    int mid = executor.submit(spinningTask(2), 3);
+    executor.waitIdle();
+    
+    std::vector<Process> records;
+    executor.drainCompleted(records);
+    ASSERT_EQ(records.size(), 3U);
+    EXPECT_EQ(records[0].pid, high);
+    EXPECT_EQ(records[1].pid, mid);
+    EXPECT_EQ(records[2].pid, low);
+}
+
+TEST(ExecutorTest, MlfqDemotesTasksThatExhaustTheirQuantum) {
+    std::vector<int> levels;
+    TaskExecutor executor(EXEC_MLFQ, 1, 100);
+    executor.submit(spinningTask(40, &levels));
+    executor.waitIdle();
+    
+    ASSERT_FALSE(levels.empty());
+    EXPECT_EQ(levels.front(), 0);
+    EXPECT_EQ(levels.back(), 2);
+}
+
+static PreemptibleTask countingTask(int steps, int* counter) {
+    for (int i = 0; i < steps; i++) {
+        auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(20);
+        while (std::chrono::steady_clock::now() < until) {}
+        (*counter)++;
+        co_await yieldPoint();
+    }
+}
+
+TEST(CoroutineTaskTest, YieldPointsDoNotSuspendOutsideExecutor) {
+    int counter = 0;
+    PreemptibleTask task = countingTask(10, &counter);
+    EXPECT_EQ(counter, 0);
+    EXPECT_TRUE(task.resume());
+    EXPECT_EQ(counter, 10);
+    EXPECT_TRUE(task.done());
+}
+
+TEST(CoroutineTaskTest, QuantumExpiryPreemptsAtYieldPoints) {
+    TaskExecutor executor(EXEC_ROUND_ROBIN, 2, 100);
+    std::vector<int> counters(200, 0);
+    for (int i = 0; i < 200; i++) {
+        submitTask(executor, countingTask(i % 4 == 0 ? 50 : 1, &counters[i]));
+    }
+    executor.waitIdle();
+    
+    ExecutorReport report = executor.report();
+    EXPECT_EQ(report.completedTasks, 200U);
+    EXPECT_GT(report.dispatches, 200U);  // long tasks were preempted
+    EXPECT_GE(report.switchCostMicros, 0.0);
+    for (int i = 0; i < 200; i++) {
+        EXPECT_EQ(counters[i], i % 4 == 0 ? 50 : 1);
+    }
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();